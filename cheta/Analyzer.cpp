@@ -0,0 +1,157 @@
+#include "Analyzer.h"
+#include "Notation.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//   :  ,      
+struct SharedState {
+    std::mutex mutex;
+    std::condition_variable resultReady;
+    std::condition_variable slotFree;
+    std::ifstream input;
+    bool inputDone = false;
+    uint64_t nextIndex = 0;     //   
+    uint64_t written = 0;       //    
+    std::vector<std::optional<std::string>> window; //    
+    uint64_t totalNodes = 0;
+    int activeWorkers = 0;
+};
+
+std::string analyseLine(Search& search, const AnalyzerConfig& config, const std::string& line, uint64_t& nodes) {
+    Position position;
+    if (!Notation::parse(line, position)) {
+        return "pos=" + line + " error=\"bad position\"\n";
+    }
+    int depth = 0;
+    std::vector<RootMoveInfo> moves = search.analyse(position, config.limits, config.multiPV, depth);
+    nodes += search.getNodes();
+    if (moves.empty()) {
+        return "pos=" + line + " error=\"no moves\"\n";
+    }
+    std::string text;
+    for (size_t rank = 0; rank < moves.size(); ++rank) {
+        std::string pv;
+        for (const Move& move : moves[rank].pv) {
+            if (!pv.empty()) pv += ' ';
+            pv += MoveGen::toString(move);
+        }
+        text += "pos=" + line + " rank=" + std::to_string(rank + 1) + " move=" + MoveGen::toString(moves[rank].move) +
+            " score=" + std::to_string(moves[rank].score) + " depth=" + std::to_string(depth) + " pv=\"" + pv + "\"\n";
+    }
+    return text;
+}
+
+void workerLoop(SharedState& state, const AnalyzerConfig& config) {
+    Search search(18);
+    uint64_t nodes = 0;
+    std::string line;
+    while (true) {
+        uint64_t index;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            //    :      
+            state.slotFree.wait(lock, [&state]() {
+                return state.inputDone || state.nextIndex < state.written + state.window.size();
+            });
+            do {
+                if (state.inputDone || !std::getline(state.input, line)) {
+                    state.inputDone = true;
+                    break;
+                }
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+            } while (line.empty() || line[0] == '#'); //     
+            if (state.inputDone) {
+                state.totalNodes += nodes;
+                --state.activeWorkers;
+                state.resultReady.notify_all();
+                state.slotFree.notify_all();
+                return;
+            }
+            index = state.nextIndex++;
+        }
+
+        search.clear(); //  
+        std::string result = analyseLine(search, config, line, nodes);
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.window[index % state.window.size()] = std::move(result);
+        }
+        state.resultReady.notify_all();
+    }
+}
+
+} // namespace
+
+BatchAnalyzer::BatchAnalyzer(const AnalyzerConfig& config) : config(config) {
+    if (this->config.threads <= 0) {
+        this->config.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+int BatchAnalyzer::run() {
+    SharedState state;
+    state.input.open(config.inputPath);
+    if (!state.input) {
+        std::cerr << "Cannot open " << config.inputPath << std::endl;
+        return 1;
+    }
+    std::ofstream output(config.outputPath, std::ios::binary);
+    if (!output) {
+        std::cerr << "Cannot create " << config.outputPath << std::endl;
+        return 1;
+    }
+    state.window.resize(static_cast<size_t>(config.threads) * windowPerThread);
+    state.activeWorkers = config.threads;
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < config.threads; ++i) {
+        workers.emplace_back(workerLoop, std::ref(state), std::cref(config));
+    }
+
+    //    :    
+    std::string pending;
+    while (true) {
+        std::string text;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            auto& slot = state.window[state.written % state.window.size()];
+            state.resultReady.wait(lock, [&state, &slot]() {
+                return slot.has_value() || (state.activeWorkers == 0 && state.written >= state.nextIndex);
+            });
+            if (!slot.has_value()) {
+                break; //  ,  
+            }
+            text = std::move(*slot);
+            slot.reset();
+            ++state.written;
+        }
+        state.slotFree.notify_all();
+        pending += text;
+        if (pending.size() >= (1 << 16)) {
+            output.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+            output.flush(); //      
+            pending.clear();
+        }
+    }
+    output.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "Analysed " << state.written << " positions on " << config.threads << " threads in "
+        << seconds << " s (" << state.written / seconds << " positions/s, "
+        << static_cast<uint64_t>(state.totalNodes / seconds) << " nodes/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include "Search.h"
+#include <string>
+
+struct AnalyzerConfig {
+    std::string inputPath;
+    std::string outputPath;
+    SearchLimits limits;  //   /   
+    int multiPV = 3;
+    int threads = 0;      // 0 -   
+};
+
+//  :    (   , FEN   Hub, . Notation.h)
+//   ,     Search.        
+// ,   :   multiPV 
+//   pos=<> rank=<n> move=<> score=<> depth=<> pv="<>"
+//         windowPerThread  ,
+//        .
+class BatchAnalyzer {
+public:
+    static const int windowPerThread = 16;
+
+    explicit BatchAnalyzer(const AnalyzerConfig& config);
+    int run(); //    main
+private:
+    AnalyzerConfig config;
+};
+
+#endif
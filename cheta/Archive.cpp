@@ -0,0 +1,513 @@
+#include "Archive.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX // std::min/std::max   windows.h
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char magic[8] = { 'C', 'H', 'E', 'T', 'A', 'A', 'R', 'C' };
+const uint32_t version = 1;
+const size_t headerSize = 8 + 4 + 4 + 4 + 8;
+const size_t packedSize = sizeof(PackedPosition);
+const size_t keyframeSize = packedSize + 4;
+
+void putUint32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putUint64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void putPacked(std::vector<uint8_t>& out, const Position& position) {
+    PackedPosition packed = Notation::pack(position);
+    out.insert(out.end(), packed.bytes, packed.bytes + packedSize);
+}
+
+uint32_t getUint32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+        (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+uint64_t getUint64(const uint8_t* in) {
+    return static_cast<uint64_t>(getUint32(in)) | (static_cast<uint64_t>(getUint32(in + 4)) << 32);
+}
+
+Position getPacked(const uint8_t* in) {
+    PackedPosition packed;
+    std::memcpy(packed.bytes, in, packedSize);
+    return Notation::unpack(packed);
+}
+
+//  ,    :  ,  
+GameState resultAfter(const Position& position) {
+    MoveList moves;
+    MoveGen::generate(position, moves);
+    if (moves.count > 0) return GameState::PLAYING;
+    return position.sideToMove == PieceColor::WHITE ? GameState::BLACK_WON : GameState::WHITE_WON;
+}
+
+} // namespace
+
+ArchiveWriter::ArchiveWriter(uint32_t keyframeInterval) :
+    keyframeInterval(std::max<uint32_t>(keyframeInterval, 1)), file(nullptr), offset(0)
+{
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+bool ArchiveWriter::open(const std::string& path)
+{
+    this->path = path;
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot create archive " << path << std::endl;
+        return false;
+    }
+    //    finish,        
+    std::vector<uint8_t> header(headerSize, 0);
+    offset = header.size();
+    return std::fwrite(header.data(), 1, header.size(), file) == header.size();
+}
+
+bool ArchiveWriter::add(const ArchivedGame& game)
+{
+    uint32_t plies = static_cast<uint32_t>(game.moves.size());
+    std::vector<uint8_t> keyframes;
+    buffer.clear();
+    Position position = game.start;
+    for (uint32_t ply = 0; ply < plies; ++ply) {
+        if (ply > 0 && ply % keyframeInterval == 0) {
+            putPacked(keyframes, position);
+            putUint32(keyframes, static_cast<uint32_t>(buffer.size()));
+        }
+        const Move& move = game.moves[ply];
+        buffer.push_back(static_cast<uint8_t>(move.pathLength + 1));
+        buffer.push_back(move.from);
+        buffer.insert(buffer.end(), move.path, move.path + move.pathLength);
+        position = MoveGen::apply(position, move);
+    }
+    if (plies > 0 && plies % keyframeInterval == 0) {
+        putPacked(keyframes, position); //    :    
+        putUint32(keyframes, static_cast<uint32_t>(buffer.size()));
+    }
+
+    std::vector<uint8_t> record;
+    putUint32(record, plies);
+    record.push_back(static_cast<uint8_t>(game.result));
+    putPacked(record, game.start);
+    putUint32(record, static_cast<uint32_t>(keyframes.size() / keyframeSize));
+    record.insert(record.end(), keyframes.begin(), keyframes.end());
+    putUint32(record, static_cast<uint32_t>(buffer.size()));
+    record.insert(record.end(), buffer.begin(), buffer.end());
+
+    index.push_back(offset);
+    offset += record.size();
+    return std::fwrite(record.data(), 1, record.size(), file) == record.size();
+}
+
+bool ArchiveWriter::finish()
+{
+    std::vector<uint8_t> tail;
+    for (uint64_t gameOffset : index) {
+        putUint64(tail, gameOffset);
+    }
+    std::vector<uint8_t> header(magic, magic + sizeof(magic));
+    putUint32(header, version);
+    putUint32(header, keyframeInterval);
+    putUint32(header, static_cast<uint32_t>(index.size()));
+    putUint64(header, offset);
+    bool ok = std::fwrite(tail.data(), 1, tail.size(), file) == tail.size() &&
+        std::fseek(file, 0, SEEK_SET) == 0 &&
+        std::fwrite(header.data(), 1, header.size(), file) == header.size();
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok) {
+        std::cerr << "Cannot write archive " << path << std::endl;
+    }
+    return ok;
+}
+
+void ArchiveWriter::discard()
+{
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    std::remove(path.c_str());
+}
+
+GameArchive::~GameArchive()
+{
+    close();
+}
+
+void GameArchive::close()
+{
+    if (data) {
+#ifdef _WIN32
+        ::UnmapViewOfFile(data);
+        ::CloseHandle(mappingHandle);
+        ::CloseHandle(fileHandle);
+        mappingHandle = fileHandle = nullptr;
+#else
+        ::munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+    data = nullptr;
+    index = nullptr;
+    size = 0;
+    count = 0;
+}
+
+bool GameArchive::open(const std::string& path)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize{};
+    if (file == INVALID_HANDLE_VALUE || !::GetFileSizeEx(file, &fileSize)) {
+        if (file != INVALID_HANDLE_VALUE) ::CloseHandle(file);
+        std::cerr << "Cannot open archive " << path << std::endl;
+        return false;
+    }
+    HANDLE mapping = fileSize.QuadPart > 0 ? ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    const void* view = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        std::cerr << "Cannot map archive " << path << std::endl;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info {};
+    if (fd == -1 || ::fstat(fd, &info) == -1) {
+        if (fd != -1) ::close(fd);
+        std::cerr << "Cannot open archive " << path << std::endl;
+        return false;
+    }
+    void* view = info.st_size > 0 ? ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd); //    
+    if (view == MAP_FAILED) {
+        std::cerr << "Cannot map archive " << path << std::endl;
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+#endif
+    data = static_cast<const uint8_t*>(view);
+
+    if (size < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0 || getUint32(data + 8) != version) {
+        std::cerr << "Not a game archive: " << path << std::endl;
+        close();
+        return false;
+    }
+    interval = getUint32(data + 12);
+    uint32_t games = getUint32(data + 16);
+    uint64_t indexOffset = getUint64(data + 20);
+    if (interval == 0 || indexOffset > size || (size - indexOffset) / 8 < games) {
+        std::cerr << "Damaged archive index: " << path << std::endl;
+        close();
+        return false;
+    }
+    index = data + indexOffset;
+    count = games;
+    return true;
+}
+
+bool GameArchive::view(size_t game, GameView& out) const
+{
+    if (game >= count) return false;
+    uint64_t offset = getUint64(index + 8 * game);
+    const size_t fixed = 4 + 1 + packedSize + 4;
+    if (offset > size || size - offset < fixed) return false;
+    const uint8_t* p = data + offset;
+    const uint8_t* end = data + size;
+    //      ( ),    -  
+    if (p[4] > static_cast<uint8_t>(GameState::DRAW)) return false;
+    out.plies = getUint32(p);
+    out.result = static_cast<GameState>(p[4]);
+    out.start = p + 5;
+    out.keyframes = getUint32(p + 5 + packedSize);
+    out.keyframe = p + fixed;
+    if (static_cast<uint64_t>(end - out.keyframe) < static_cast<uint64_t>(out.keyframes) * keyframeSize + 4) return false;
+    const uint8_t* turnHeader = out.keyframe + static_cast<size_t>(out.keyframes) * keyframeSize;
+    out.turnBytes = getUint32(turnHeader);
+    out.turns = turnHeader + 4;
+    return static_cast<uint64_t>(end - out.turns) >= out.turnBytes;
+}
+
+uint32_t GameArchive::plyCount(size_t game) const
+{
+    GameView header;
+    return view(game, header) ? header.plies : 0;
+}
+
+GameState GameArchive::result(size_t game) const
+{
+    GameView header;
+    return view(game, header) ? header.result : GameState::PLAYING;
+}
+
+bool GameArchive::applyTurns(const GameView& game, uint32_t offset, uint32_t count, Position& position)
+{
+    Move move;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (offset >= game.turnBytes) return false;
+        uint8_t squares = game.turns[offset];
+        if (game.turnBytes - offset - 1 < squares ||
+            !MoveGen::fromSquares(position, game.turns + offset + 1, squares, move)) {
+            return false;
+        }
+        position = MoveGen::apply(position, move);
+        offset += 1 + squares;
+    }
+    return true;
+}
+
+bool GameArchive::seek(size_t game, uint32_t ply, Position& position) const
+{
+    GameView header;
+    if (!view(game, header) || ply > header.plies) return false;
+    uint32_t keyframe = std::min(ply / interval, header.keyframes);
+    if (keyframe == 0) {
+        position = getPacked(header.start);
+        return applyTurns(header, 0, ply, position);
+    }
+    const uint8_t* entry = header.keyframe + static_cast<size_t>(keyframe - 1) * keyframeSize;
+    position = getPacked(entry);
+    return applyTurns(header, getUint32(entry + packedSize), ply - keyframe * interval, position);
+}
+
+bool GameArchive::replay(size_t game, uint32_t ply, Position& position) const
+{
+    GameView header;
+    if (!view(game, header) || ply > header.plies) return false;
+    position = getPacked(header.start);
+    return applyTurns(header, 0, ply, position);
+}
+
+bool GameArchive::load(size_t game, ArchivedGame& out) const
+{
+    GameView header;
+    if (!view(game, header)) return false;
+    out.start = getPacked(header.start);
+    out.result = header.result;
+    out.moves.clear();
+    Position position = out.start;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < header.plies; ++i) {
+        Move move;
+        if (offset >= header.turnBytes || header.turnBytes - offset - 1 < header.turns[offset] ||
+            !MoveGen::fromSquares(position, header.turns + offset + 1, header.turns[offset], move)) {
+            return false;
+        }
+        out.moves.push_back(move);
+        position = MoveGen::apply(position, move);
+        offset += 1 + header.turns[offset];
+    }
+    return true;
+}
+
+int runArchiveGenerate(const std::string& path, int games, int maxPlies, uint32_t keyframeInterval, unsigned seed)
+{
+    ArchiveWriter writer(keyframeInterval);
+    if (!writer.open(path)) {
+        return 1;
+    }
+    std::mt19937 rng(seed);
+    uint64_t totalPlies = 0;
+    ArchivedGame game;
+    MoveList moves;
+    for (int i = 0; i < games; ++i) {
+        game.moves.clear();
+        Position position = game.start;
+        for (int ply = 0; ply < maxPlies; ++ply) {
+            MoveGen::generate(position, moves);
+            if (moves.count == 0) break;
+            //  ,       :  
+            //      ,     
+            int safe = 0;
+            for (int m = 0; m < moves.count; ++m) {
+                if (!MoveGen::hasCapture(MoveGen::apply(position, moves.moves[m]))) {
+                    std::swap(moves.moves[m], moves.moves[safe++]);
+                }
+            }
+            int choices = safe > 0 ? safe : moves.count;
+            const Move& move = moves.moves[std::uniform_int_distribution<int>(0, choices - 1)(rng)];
+            game.moves.push_back(move);
+            position = MoveGen::apply(position, move);
+        }
+        game.result = resultAfter(position);
+        totalPlies += game.moves.size();
+        if (!writer.add(game)) {
+            std::cerr << "Cannot write archive " << path << std::endl;
+            return 1;
+        }
+    }
+    if (!writer.finish()) {
+        return 1;
+    }
+    std::cout << "Archive " << path << ": " << games << " games, " << totalPlies << " plies, keyframe every "
+        << keyframeInterval << " plies" << std::endl;
+    return 0;
+}
+
+int runArchiveImport(const std::string& textPath, const std::string& path, uint32_t keyframeInterval)
+{
+    std::ifstream in(textPath);
+    if (!in) {
+        std::cerr << "Cannot open " << textPath << std::endl;
+        return 1;
+    }
+    ArchiveWriter writer(keyframeInterval);
+    if (!writer.open(path)) {
+        return 1;
+    }
+    std::string line;
+    int lineNumber = 0;
+    int imported = 0;
+    ArchivedGame game;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::istringstream tokens(line);
+        std::string token;
+        if (!(tokens >> token) || token[0] == '#') continue;
+
+        game.start = Position::initial();
+        game.moves.clear();
+        bool hasResult = false;
+        if (token.find(':') != std::string::npos) {
+            if (!Notation::parse(token, game.start)) {
+                std::cerr << textPath << ":" << lineNumber << ": bad position " << token << std::endl;
+                return 1;
+            }
+            token.clear();
+            tokens >> token;
+        }
+        Position position = game.start;
+        for (; !token.empty(); token.clear(), tokens >> token) {
+            if (token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*") {
+                game.result = token == "1-0" ? GameState::WHITE_WON : token == "0-1" ? GameState::BLACK_WON :
+                    token == "*" ? GameState::PLAYING : GameState::DRAW;
+                hasResult = true;
+                break;
+            }
+            Move move;
+            if (!MoveGen::parse(position, token, move)) {
+                std::cerr << textPath << ":" << lineNumber << ": illegal move " << token << " at ply "
+                    << game.moves.size() + 1 << std::endl;
+                return 1;
+            }
+            game.moves.push_back(move);
+            position = MoveGen::apply(position, move);
+        }
+        if (!hasResult) {
+            game.result = resultAfter(position);
+        }
+        if (!writer.add(game)) {
+            return 1;
+        }
+        ++imported;
+    }
+    if (!writer.finish()) {
+        return 1;
+    }
+    std::cout << "Imported " << imported << " games into " << path << std::endl;
+    return 0;
+}
+
+int runArchivePosition(const std::string& path, size_t game, uint32_t ply)
+{
+    GameArchive archive;
+    if (!archive.open(path)) {
+        return 1;
+    }
+    Position position;
+    if (!archive.seek(game, ply, position)) {
+        std::cerr << "No ply " << ply << " in game " << game << " (" << archive.gameCount() << " games)" << std::endl;
+        return 1;
+    }
+    std::cout << Notation::toString(position) << std::endl;
+    return 0;
+}
+
+int runArchiveSeekBench(const std::string& path, int samples)
+{
+    GameArchive archive;
+    if (!archive.open(path)) {
+        return 1;
+    }
+    if (archive.gameCount() == 0) {
+        std::cerr << "Archive is empty" << std::endl;
+        return 1;
+    }
+    //   :    ,     
+    const uint32_t bounds[] = { 64, 128, 256, 512, 1024, 2048, UINT32_MAX };
+    const int bucketCount = sizeof(bounds) / sizeof(bounds[0]);
+    uint64_t count[bucketCount] = {};
+    double seekNs[bucketCount] = {};
+    double replayNs[bucketCount] = {};
+    uint64_t mismatches = 0;
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<size_t> pickGame(0, archive.gameCount() - 1);
+    for (int i = 0; i < samples; ++i) {
+        size_t game = pickGame(rng);
+        uint32_t ply = std::uniform_int_distribution<uint32_t>(0, archive.plyCount(game))(rng);
+        Position seeked, replayed;
+        auto started = std::chrono::steady_clock::now();
+        bool ok = archive.seek(game, ply, seeked);
+        auto middle = std::chrono::steady_clock::now();
+        ok = archive.replay(game, ply, replayed) && ok;
+        auto finished = std::chrono::steady_clock::now();
+        if (!ok || !(seeked == replayed)) {
+            ++mismatches;
+        }
+        int bucket = 0;
+        while (ply >= bounds[bucket]) ++bucket;
+        ++count[bucket];
+        seekNs[bucket] += std::chrono::duration<double, std::nano>(middle - started).count();
+        replayNs[bucket] += std::chrono::duration<double, std::nano>(finished - middle).count();
+    }
+
+    std::cout << "Archive: " << archive.gameCount() << " games, keyframe every " << archive.keyframeInterval() << " plies" << std::endl;
+    std::printf("%-14s %10s %14s %14s\n", "plies", "samples", "seek ns", "replay ns");
+    uint32_t lower = 0;
+    for (int bucket = 0; bucket < bucketCount; ++bucket) {
+        if (count[bucket] > 0) {
+            std::string range = std::to_string(lower) + "-" + (bounds[bucket] == UINT32_MAX ? std::string("") : std::to_string(bounds[bucket] - 1));
+            std::printf("%-14s %10llu %14.0f %14.0f\n", range.c_str(), static_cast<unsigned long long>(count[bucket]),
+                seekNs[bucket] / count[bucket], replayNs[bucket] / count[bucket]);
+        }
+        lower = bounds[bucket];
+    }
+    std::cout << "Mismatches between seek and replay: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
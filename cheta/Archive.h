@@ -0,0 +1,107 @@
+#ifndef ARCHIVE_H
+#define ARCHIVE_H
+
+#include "MoveGen.h"
+#include "Notation.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//      .  ( little-endian):
+//   : "CHETAARC" |  (4) | K -    (4) |   (4) |   (8)
+//    , :
+//       (4) |  GameState (1) |   PackedPosition (11)
+//        (4) |  : PackedPosition (11) +      (4)
+//        (4) | :   n (1)  n  (  , 0..31)
+//   :       (8)
+//   i ( ) -   i*K ,     i*K.
+//               
+// K-1 ,       .
+struct ArchivedGame {
+    Position start = Position::initial();
+    GameState result = GameState::PLAYING; // PLAYING -   
+    std::vector<Move> moves;
+};
+
+class ArchiveWriter {
+public:
+    static const uint32_t defaultKeyframeInterval = 16;
+
+    explicit ArchiveWriter(uint32_t keyframeInterval = defaultKeyframeInterval);
+    ~ArchiveWriter();
+
+    bool open(const std::string& path);    // false   ( )
+    bool add(const ArchivedGame& game);    //    
+    bool finish();                         //    ,  
+    void discard();                        //     
+
+private:
+    uint32_t keyframeInterval;
+    std::FILE* file;
+    std::string path;
+    uint64_t offset;
+    std::vector<uint64_t> index;
+    std::vector<uint8_t> buffer; //    , 
+};
+
+//       :    ,  
+//      (     ).  
+//  ,   GameArchive      .
+class GameArchive {
+public:
+    GameArchive() = default;
+    ~GameArchive();
+    GameArchive(const GameArchive&) = delete;
+    GameArchive& operator=(const GameArchive&) = delete;
+
+    bool open(const std::string& path); // false   ( )
+    void close();
+
+    size_t gameCount() const { return count; }
+    uint32_t keyframeInterval() const { return interval; }
+    uint32_t plyCount(size_t game) const;
+    GameState result(size_t game) const;
+
+    //   ply   game (0 - ). false,    .
+    bool seek(size_t game, uint32_t ply, Position& position) const;
+    //      -      (   )
+    bool replay(size_t game, uint32_t ply, Position& position) const;
+    bool load(size_t game, ArchivedGame& out) const;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    const uint8_t* index = nullptr; //  ,  
+    uint32_t count = 0;
+    uint32_t interval = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    //   :   data
+    struct GameView {
+        uint32_t plies;
+        GameState result;
+        const uint8_t* start;       // PackedPosition
+        uint32_t keyframes;
+        const uint8_t* keyframe;    // keyframes   15 
+        const uint8_t* turns;
+        uint32_t turnBytes;
+    };
+    bool view(size_t game, GameView& out) const;
+    static bool applyTurns(const GameView& game, uint32_t offset, uint32_t count, Position& position);
+};
+
+//   .    main.
+//   (MoveGen)   maxPlies 
+int runArchiveGenerate(const std::string& path, int games, int maxPlies, uint32_t keyframeInterval, unsigned seed);
+//  :    -  FEN,    MoveGen::toString
+int runArchiveImport(const std::string& textPath, const std::string& path, uint32_t keyframeInterval);
+//   ply   game  FEN
+int runArchivePosition(const std::string& path, size_t game, uint32_t ply);
+//         :       
+int runArchiveSeekBench(const std::string& path, int samples);
+
+#endif
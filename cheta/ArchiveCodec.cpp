@@ -0,0 +1,630 @@
+#include "ArchiveCodec.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const char magic[8] = { 'C', 'H', 'E', 'T', 'A', 'C', 'M', 'P' };
+const uint32_t version = 1;
+const size_t headerSize = 8 + 4 + 4 + 4 + 4 + 4 + 8;
+
+void putUint32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void putUint64(uint8_t* out, uint64_t value) {
+    putUint32(out, static_cast<uint32_t>(value));
+    putUint32(out + 4, static_cast<uint32_t>(value >> 32));
+}
+
+uint32_t getUint32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+        (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+uint64_t getUint64(const uint8_t* in) {
+    return static_cast<uint64_t>(getUint32(in)) | (static_cast<uint64_t>(getUint32(in + 4)) << 32);
+}
+
+// fseek  64- :     2 ,  long  Windows 32-
+bool seekTo(std::FILE* file, uint64_t offset) {
+#ifdef _WIN32
+    return ::_fseeki64(file, static_cast<long long>(offset), SEEK_SET) == 0;
+#else
+    return ::fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+uint64_t fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in ? static_cast<uint64_t>(in.tellg()) : 0;
+}
+
+//     (  LZMA): low - 33 , range - 32.  0xFF,  
+//    ,   cacheSize  ,    .
+// total  encode   2^16:   range >= 2^24,  .
+class RangeEncoder {
+public:
+    explicit RangeEncoder(std::vector<uint8_t>& out) : out(out), low(0), range(0xFFFFFFFFu), cache(0), cacheSize(1) {}
+
+    void encode(uint32_t start, uint32_t size, uint32_t total) {
+        range /= total;
+        low += static_cast<uint64_t>(start) * range;
+        range *= size;
+        while (range < (1u << 24)) {
+            range <<= 8;
+            shiftLow();
+        }
+    }
+
+    void finish() {
+        for (int i = 0; i < 5; ++i) {
+            shiftLow();
+        }
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t low;
+    uint32_t range;
+    uint8_t cache;
+    uint64_t cacheSize;
+
+    void shiftLow() {
+        if (static_cast<uint32_t>(low) < 0xFF000000u || (low >> 32) != 0) {
+            uint8_t carry = static_cast<uint8_t>(low >> 32);
+            uint8_t pending = cache;
+            do {
+                out.push_back(static_cast<uint8_t>(pending + carry));
+                pending = 0xFF;
+            } while (--cacheSize != 0);
+            cache = static_cast<uint8_t>(low >> 24);
+        }
+        ++cacheSize;
+        low = (low & 0x00FFFFFFu) << 8;
+    }
+};
+
+class RangeDecoder {
+public:
+    RangeDecoder(const uint8_t* data, size_t size) : data(data), size(size), position(0), code(0), range(0xFFFFFFFFu) {
+        for (int i = 0; i < 5; ++i) {
+            code = (code << 8) | next();
+        }
+    }
+
+    //   [0, total),    ;  decode   
+    uint32_t threshold(uint32_t total) {
+        range /= total;
+        return std::min(code / range, total - 1); //  total ,   
+    }
+
+    void decode(uint32_t start, uint32_t size) {
+        code -= start * range;
+        range *= size;
+        while (range < (1u << 24)) {
+            code = (code << 8) | next();
+            range <<= 8;
+        }
+    }
+
+    uint32_t decodeUniform(uint32_t total) {
+        uint32_t value = threshold(total);
+        decode(value, 1);
+        return value;
+    }
+
+    bool overrun() const { return position > size; } //     -  
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    uint32_t code;
+    uint32_t range;
+
+    uint8_t next() {
+        uint8_t value = position < size ? data[position] : 0;
+        ++position;
+        return value;
+    }
+};
+
+//   symbols .  ,   
+//  ,  .
+template <int symbols>
+class FrequencyModel {
+public:
+    FrequencyModel() : total(symbols) {
+        std::fill(freq, freq + symbols, 1u);
+    }
+
+    void encode(RangeEncoder& encoder, int symbol) {
+        uint32_t start = 0;
+        for (int s = 0; s < symbol; ++s) {
+            start += freq[s];
+        }
+        encoder.encode(start, freq[symbol], total);
+        update(symbol);
+    }
+
+    int decode(RangeDecoder& decoder) {
+        uint32_t target = decoder.threshold(total);
+        uint32_t start = 0;
+        int symbol = 0;
+        while (start + freq[symbol] <= target) {
+            start += freq[symbol++];
+        }
+        decoder.decode(start, freq[symbol]);
+        update(symbol);
+        return symbol;
+    }
+
+private:
+    static const uint32_t increment = 24;
+    static const uint32_t limit = 1u << 16;
+    uint32_t freq[symbols];
+    uint32_t total;
+
+    void update(int symbol) {
+        freq[symbol] += increment;
+        total += increment;
+        if (total > limit) {
+            //     :    
+            total = 0;
+            for (uint32_t& f : freq) {
+                f = (f + 1) / 2;
+                total += f;
+            }
+        }
+    }
+};
+
+//  :      2..16+   / .
+//   escapeRank   -  escapeRank   .
+const int countContexts = 15;
+const int escapeRank = 15;
+
+struct BlockModels {
+    FrequencyModel<2> start;      // 0 -   
+    FrequencyModel<4> result;     // GameState
+    FrequencyModel<33> plyBits;   //   
+    FrequencyModel<escapeRank + 1> rank[2][countContexts];
+
+    FrequencyModel<escapeRank + 1>& rankModel(const MoveList& moves) {
+        return rank[moves.moves[0].isCapture() ? 1 : 0][std::min(moves.count, countContexts + 1) - 2];
+    }
+};
+
+// :  ,       16 
+void encodeNumber(RangeEncoder& encoder, FrequencyModel<33>& bits, uint32_t value) {
+    int width = std::bit_width(value);
+    bits.encode(encoder, width);
+    for (int shift = 0; shift < width - 1; shift += 16) {
+        int chunk = std::min(16, width - 1 - shift);
+        encoder.encode((value >> shift) & ((1u << chunk) - 1), 1, 1u << chunk);
+    }
+}
+
+uint32_t decodeNumber(RangeDecoder& decoder, FrequencyModel<33>& bits) {
+    int width = bits.decode(decoder);
+    if (width == 0) return 0;
+    uint32_t value = 1u << (width - 1);
+    for (int shift = 0; shift < width - 1; shift += 16) {
+        int chunk = std::min(16, width - 1 - shift);
+        value |= decoder.decodeUniform(1u << chunk) << shift;
+    }
+    return value;
+}
+
+struct EncodedBlock {
+    std::vector<uint8_t> bytes;
+    uint64_t plies = 0;
+    uint64_t forced = 0;
+    uint64_t indexBits = 0; //     : ceil(log2( ))  
+    bool ok = false;
+};
+
+struct DecodedBlock {
+    std::vector<uint8_t> bytes;       //  , 
+    std::vector<ArchivedGame> games;
+    size_t count = 0;
+    uint64_t plies = 0;
+    bool ok = false;
+};
+
+void encodeBlock(const GameArchive& archive, size_t first, size_t count, EncodedBlock& out)
+{
+    out.bytes.clear();
+    out.plies = out.forced = out.indexBits = 0;
+    out.ok = false;
+    RangeEncoder encoder(out.bytes);
+    BlockModels models; //  :    
+    ArchivedGame game;
+    MoveList moves;
+    for (size_t i = first; i < first + count; ++i) {
+        if (!archive.load(i, game)) return;
+        bool initial = game.start == Position::initial();
+        models.start.encode(encoder, initial ? 0 : 1);
+        if (!initial) {
+            PackedPosition packed = Notation::pack(game.start);
+            for (uint8_t byte : packed.bytes) {
+                encoder.encode(byte, 1, 256);
+            }
+        }
+        models.result.encode(encoder, static_cast<int>(game.result));
+        encodeNumber(encoder, models.plyBits, static_cast<uint32_t>(game.moves.size()));
+
+        Position position = game.start;
+        for (const Move& move : game.moves) {
+            MoveGen::generate(position, moves);
+            if (moves.count > 1) {
+                ArchiveCodec::orderMoves(position, moves);
+            }
+            int rank = 0;
+            while (rank < moves.count && !(moves.moves[rank] == move)) {
+                ++rank;
+            }
+            if (rank == moves.count) return; //     MoveGen:    
+            if (moves.count == 1) {
+                ++out.forced; //    
+            }
+            else {
+                models.rankModel(moves).encode(encoder, std::min(rank, escapeRank));
+                if (rank >= escapeRank) {
+                    encoder.encode(static_cast<uint32_t>(rank - escapeRank), 1, static_cast<uint32_t>(moves.count - escapeRank));
+                }
+                out.indexBits += std::bit_width(static_cast<unsigned>(moves.count - 1));
+            }
+            position = MoveGen::apply(position, move);
+        }
+        out.plies += game.moves.size();
+    }
+    encoder.finish();
+    out.ok = true;
+}
+
+void decodeBlock(size_t count, DecodedBlock& out)
+{
+    out.ok = false;
+    out.plies = 0;
+    out.count = count;
+    if (out.games.size() < count) {
+        out.games.resize(count);
+    }
+    RangeDecoder decoder(out.bytes.data(), out.bytes.size());
+    BlockModels models;
+    MoveList moves;
+    for (size_t i = 0; i < count; ++i) {
+        ArchivedGame& game = out.games[i];
+        if (models.start.decode(decoder) == 0) {
+            game.start = Position::initial();
+        }
+        else {
+            PackedPosition packed;
+            for (uint8_t& byte : packed.bytes) {
+                byte = static_cast<uint8_t>(decoder.decodeUniform(256));
+            }
+            game.start = Notation::unpack(packed);
+        }
+        game.result = static_cast<GameState>(models.result.decode(decoder));
+        uint32_t plies = decodeNumber(decoder, models.plyBits);
+
+        game.moves.clear();
+        Position position = game.start;
+        for (uint32_t ply = 0; ply < plies; ++ply) {
+            MoveGen::generate(position, moves);
+            int rank = 0;
+            if (moves.count > 1) {
+                ArchiveCodec::orderMoves(position, moves);
+                rank = models.rankModel(moves).decode(decoder);
+                if (rank == escapeRank && moves.count > escapeRank) {
+                    rank += static_cast<int>(decoder.decodeUniform(static_cast<uint32_t>(moves.count - escapeRank)));
+                }
+            }
+            if (rank >= moves.count || decoder.overrun()) return;
+            game.moves.push_back(moves.moves[rank]);
+            position = MoveGen::apply(position, moves.moves[rank]);
+        }
+        out.plies += plies;
+        if (decoder.overrun()) return;
+    }
+    out.ok = true;
+}
+
+//  0..count-1    threads ,  consume   
+//     .      window  
+// ,      window     .
+//         consume    .
+// false,  consume  false (   ).
+template <typename Result, typename Produce, typename Consume>
+bool runOrdered(size_t count, int threads, size_t window, Produce produce, Consume consume)
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<Result> slots(window);
+    std::vector<uint8_t> filled(window, 0);
+    size_t next = 0;
+    size_t consumed = 0;
+    bool stopped = false;
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            Result result;
+            while (true) {
+                size_t task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() { return stopped || next >= count || next < consumed + window; });
+                    if (stopped || next >= count) return;
+                    task = next++;
+                }
+                produce(task, result);
+                std::lock_guard<std::mutex> lock(mutex);
+                std::swap(slots[task % window], result);
+                filled[task % window] = 1;
+                changed.notify_all();
+            }
+        });
+    }
+
+    bool ok = true;
+    Result result;
+    for (size_t task = 0; task < count && ok; ++task) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return filled[task % window] != 0; });
+            std::swap(slots[task % window], result);
+            filled[task % window] = 0;
+            ++consumed;
+            changed.notify_all();
+        }
+        ok = consume(task, result);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+        changed.notify_all();
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return ok;
+}
+
+int threadCount(const CodecConfig& config) {
+    return config.threads > 0 ? config.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+size_t windowSize(const CodecConfig& config, int threads) {
+    return config.window > 0 ? config.window : 4 * static_cast<size_t>(threads);
+}
+
+double perSecond(uint64_t count, double seconds) {
+    return static_cast<double>(count) / std::max(seconds, 1e-9);
+}
+
+} // namespace
+
+void ArchiveCodec::orderMoves(const Position& position, MoveList& list)
+{
+    int keys[MoveList::capacity];
+    for (int i = 0; i < list.count; ++i) {
+        const Move& move = list.moves[i];
+        bool safe = !MoveGen::hasCapture(MoveGen::apply(position, move));
+        keys[i] = (safe ? 64 : 0) + (move.promotes ? 32 : 0) + std::popcount(move.captured);
+    }
+    //      :    
+    for (int i = 1; i < list.count; ++i) {
+        Move move = list.moves[i];
+        int key = keys[i];
+        int j = i;
+        for (; j > 0 && keys[j - 1] < key; --j) {
+            list.moves[j] = list.moves[j - 1];
+            keys[j] = keys[j - 1];
+        }
+        list.moves[j] = move;
+        keys[j] = key;
+    }
+}
+
+bool ArchiveCodec::pack(const std::string& source, const std::string& packed, const CodecConfig& config)
+{
+    GameArchive archive;
+    if (!archive.open(source)) {
+        return false;
+    }
+    std::FILE* file = std::fopen(packed.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Cannot create " << packed << std::endl;
+        return false;
+    }
+    uint32_t blockGames = std::max<uint32_t>(config.blockGames, 1);
+    size_t games = archive.gameCount();
+    size_t blocks = (games + blockGames - 1) / blockGames;
+    int threads = threadCount(config);
+
+    //    ,     
+    uint8_t header[headerSize] = {};
+    bool ok = std::fwrite(header, 1, headerSize, file) == headerSize;
+    std::vector<uint64_t> offsets;
+    uint64_t offset = headerSize;
+    uint64_t plies = 0, forced = 0, indexBits = 0;
+    auto started = std::chrono::steady_clock::now();
+
+    ok = ok && runOrdered<EncodedBlock>(blocks, threads, windowSize(config, threads),
+        [&](size_t block, EncodedBlock& out) {
+            size_t first = block * blockGames;
+            encodeBlock(archive, first, std::min<size_t>(blockGames, games - first), out);
+        },
+        [&](size_t block, const EncodedBlock& encoded) {
+            if (!encoded.ok) {
+                std::cerr << "Cannot pack block " << block << ": damaged game or move not allowed by MoveGen" << std::endl;
+                return false;
+            }
+            offsets.push_back(offset);
+            offset += encoded.bytes.size();
+            plies += encoded.plies;
+            forced += encoded.forced;
+            indexBits += encoded.indexBits;
+            return std::fwrite(encoded.bytes.data(), 1, encoded.bytes.size(), file) == encoded.bytes.size();
+        });
+
+    std::vector<uint8_t> index(8 * offsets.size());
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        putUint64(index.data() + 8 * i, offsets[i]);
+    }
+    std::memcpy(header, magic, sizeof(magic));
+    putUint32(header + 8, version);
+    putUint32(header + 12, blockGames);
+    putUint32(header + 16, static_cast<uint32_t>(games));
+    putUint32(header + 20, archive.keyframeInterval());
+    putUint32(header + 24, static_cast<uint32_t>(blocks));
+    putUint64(header + 28, offset);
+    ok = ok && std::fwrite(index.data(), 1, index.size(), file) == index.size() &&
+        std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(header, 1, headerSize, file) == headerSize;
+    ok = std::fclose(file) == 0 && ok;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (!ok) {
+        std::cerr << "Cannot write " << packed << std::endl;
+        std::remove(packed.c_str());
+        return false;
+    }
+
+    uint64_t sourceBytes = fileSize(source);
+    uint64_t packedBytes = offset + index.size();
+    char line[160];
+    std::snprintf(line, sizeof(line), "Source: %zu games, %llu plies, %llu bytes", games,
+        static_cast<unsigned long long>(plies), static_cast<unsigned long long>(sourceBytes));
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Packed: %llu bytes in %zu blocks, ratio %.1f, %.3f bits per ply, %.1f%% plies forced",
+        static_cast<unsigned long long>(packedBytes), blocks, packedBytes ? static_cast<double>(sourceBytes) / packedBytes : 0.0,
+        plies ? 8.0 * static_cast<double>(offset - headerSize) / plies : 0.0, plies ? 100.0 * forced / plies : 0.0);
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Fixed-width move numbers would take %llu bytes (%.3f bits per ply)",
+        static_cast<unsigned long long>((indexBits + 7) / 8), plies ? static_cast<double>(indexBits) / plies : 0.0);
+    std::cout << line << std::endl;
+    std::snprintf(line, sizeof(line), "Pack: %d threads, %.3f s, %.0f games/s", threads, seconds, perSecond(games, seconds));
+    std::cout << line << std::endl;
+    return true;
+}
+
+bool ArchiveCodec::unpack(const std::string& packed, const std::string& target, const CodecConfig& config)
+{
+    std::FILE* file = std::fopen(packed.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Cannot open " << packed << std::endl;
+        return false;
+    }
+    uint8_t header[headerSize];
+    if (std::fread(header, 1, headerSize, file) != headerSize || std::memcmp(header, magic, sizeof(magic)) != 0 ||
+        getUint32(header + 8) != version) {
+        std::cerr << "Not a packed game archive: " << packed << std::endl;
+        std::fclose(file);
+        return false;
+    }
+    uint32_t blockGames = getUint32(header + 12);
+    uint32_t games = getUint32(header + 16);
+    uint32_t keyframeInterval = getUint32(header + 20);
+    uint32_t blocks = getUint32(header + 24);
+    uint64_t indexOffset = getUint64(header + 28);
+    //       :     ,
+    //     ,    games
+    uint64_t packedBytes = fileSize(packed);
+    bool valid = blockGames > 0 && static_cast<uint64_t>(blocks) * blockGames >= games &&
+        blocks <= (static_cast<uint64_t>(games) + blockGames - 1) / blockGames &&
+        indexOffset <= packedBytes && 8 * static_cast<uint64_t>(blocks) <= packedBytes - indexOffset;
+    std::vector<uint8_t> index(valid ? 8 * static_cast<size_t>(blocks) : 0);
+    std::vector<uint64_t> offsets(valid ? static_cast<size_t>(blocks) + 1 : 0, indexOffset);
+    valid = valid && seekTo(file, indexOffset) && std::fread(index.data(), 1, index.size(), file) == index.size();
+    for (uint32_t i = 0; valid && i < blocks; ++i) {
+        offsets[i] = getUint64(index.data() + 8 * i);
+        valid = offsets[i] >= headerSize && offsets[i] <= indexOffset && (i == 0 || offsets[i] >= offsets[i - 1]);
+    }
+    if (!valid) {
+        std::cerr << "Damaged packed archive index: " << packed << std::endl;
+        std::fclose(file);
+        return false;
+    }
+
+    ArchiveWriter writer(keyframeInterval);
+    if (!target.empty() && !writer.open(target)) {
+        std::fclose(file);
+        return false;
+    }
+    int threads = threadCount(config);
+    std::mutex fileMutex; //   - ,    
+    uint64_t plies = 0;
+    auto started = std::chrono::steady_clock::now();
+
+    bool ok = runOrdered<DecodedBlock>(blocks, threads, windowSize(config, threads),
+        [&](size_t block, DecodedBlock& out) {
+            size_t first = block * static_cast<size_t>(blockGames);
+            size_t count = first < games ? std::min<size_t>(blockGames, games - first) : 0;
+            out.bytes.resize(static_cast<size_t>(offsets[block + 1] - offsets[block]));
+            bool read;
+            {
+                std::lock_guard<std::mutex> lock(fileMutex);
+                read = seekTo(file, offsets[block]) &&
+                    std::fread(out.bytes.data(), 1, out.bytes.size(), file) == out.bytes.size();
+            }
+            out.ok = false;
+            if (read) {
+                decodeBlock(count, out);
+            }
+        },
+        [&](size_t block, const DecodedBlock& decoded) {
+            if (!decoded.ok) {
+                std::cerr << "Damaged block " << block << " in " << packed << std::endl;
+                return false;
+            }
+            plies += decoded.plies;
+            for (size_t i = 0; i < decoded.count && !target.empty(); ++i) {
+                if (!writer.add(decoded.games[i])) {
+                    std::cerr << "Cannot write archive " << target << std::endl;
+                    return false;
+                }
+            }
+            return true;
+        });
+    std::fclose(file);
+    if (!target.empty()) {
+        //          
+        ok = ok && writer.finish();
+        if (!ok) {
+            writer.discard();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (!ok) {
+        return false;
+    }
+
+    std::cout << "Unpacked " << games << " games (" << plies << " plies) from " << blocks << " blocks"
+        << (target.empty() ? std::string() : " into " + target) << std::endl;
+    char line[160];
+    std::snprintf(line, sizeof(line), "Unpack: %d threads, %.3f s, %.0f games/s, %.0f plies/s", threads, seconds,
+        perSecond(games, seconds), perSecond(plies, seconds));
+    std::cout << line << std::endl;
+    return true;
+}
+
+int runArchivePack(const std::string& source, const std::string& packed, const CodecConfig& config)
+{
+    return ArchiveCodec::pack(source, packed, config) ? 0 : 1;
+}
+
+int runArchiveUnpack(const std::string& packed, const std::string& target, const CodecConfig& config)
+{
+    return ArchiveCodec::unpack(packed, target, config) ? 0 : 1;
+}
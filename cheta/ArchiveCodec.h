@@ -0,0 +1,48 @@
+#ifndef ARCHIVE_CODEC_H
+#define ARCHIVE_CODEC_H
+
+#include "Archive.h"
+#include <cstdint>
+#include <string>
+
+//      (      :  
+//     GameArchive).    ,   
+//      orderMoves.   
+//          ,  
+//  (,   )     ,    -
+//  .
+//
+//      blockGames,       
+//    :     .  (little-endian):
+//   : "CHETACMP" |  (4) |    (4) |   (4) |
+//                   (4) |   (4) |   (8)
+//    :   ,   :
+//       -  " "  11  PackedPosition,  ,
+//      GameState,  ,    
+//   :       (8);   -  
+//    
+struct CodecConfig {
+    int threads = 0;          // 0 -   
+    uint32_t blockGames = 4096;
+    size_t window = 0;        //    , 0 -   .  
+};
+
+class ArchiveCodec {
+public:
+    //  ,    :  ,    
+    // ,  ,       ;   -
+    //  MoveGen.     ,    -  .
+    static void orderMoves(const Position& position, MoveList& list);
+
+    //   source  packed.  ,    .
+    static bool pack(const std::string& source, const std::string& packed, const CodecConfig& config);
+    //  packed    target;  target -    
+    //   .    .
+    static bool unpack(const std::string& packed, const std::string& target, const CodecConfig& config);
+};
+
+//   .    main.
+int runArchivePack(const std::string& source, const std::string& packed, const CodecConfig& config);
+int runArchiveUnpack(const std::string& packed, const std::string& target, const CodecConfig& config);
+
+#endif
@@ -0,0 +1,225 @@
+#include "ArchiveStats.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+namespace {
+
+int countBits(uint32_t mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+}
+
+int lengthBucket(uint32_t plies) {
+    int bucket = 0;
+    for (uint32_t bound = 16; bucket + 1 < ArchiveStatistics::lengthBucketCount && plies >= bound; bound *= 2) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+}
+
+//  :  [first, first + count)  
+struct Chunk {
+    size_t archive;
+    size_t first;
+    size_t count;
+};
+
+} // namespace
+
+void ArchiveStatistics::Outcome::add(GameState result)
+{
+    ++games;
+    if (result == GameState::WHITE_WON) ++whiteWins;
+    else if (result == GameState::BLACK_WON) ++blackWins;
+    else if (result == GameState::DRAW) ++draws;
+}
+
+void ArchiveStatistics::Outcome::merge(const Outcome& other)
+{
+    games += other.games;
+    whiteWins += other.whiteWins;
+    blackWins += other.blackWins;
+    draws += other.draws;
+}
+
+void ArchiveStatistics::addGame(const ArchivedGame& game, int openingPlies)
+{
+    uint32_t length = static_cast<uint32_t>(game.moves.size());
+    ++games;
+    plies += length;
+    longest = std::max(longest, length);
+    ++lengths[lengthBucket(length)];
+    results.add(game.result);
+
+    bool promoted = false;
+    bool firstCaptureSeen = false;
+    for (const Move& move : game.moves) {
+        if (move.promotes) {
+            ++promotions;
+            promoted = true;
+        }
+        if (move.isCapture()) {
+            ++captureMoves;
+            capturedPieces += countBits(move.captured);
+            if (!firstCaptureSeen) {
+                ++firstCaptures[MoveGen::toString(move)];
+                firstCaptureSeen = true;
+            }
+        }
+    }
+    gamesWithPromotion += promoted;
+
+    //        ,      
+    if (game.start == Position::initial() && length >= static_cast<uint32_t>(openingPlies)) {
+        std::string key;
+        for (int i = 0; i < openingPlies; ++i) {
+            if (i > 0) key += ' ';
+            key += MoveGen::toString(game.moves[i]);
+        }
+        openings[key].add(game.result);
+    }
+}
+
+void ArchiveStatistics::merge(const ArchiveStatistics& other)
+{
+    games += other.games;
+    plies += other.plies;
+    longest = std::max(longest, other.longest);
+    for (int i = 0; i < lengthBucketCount; ++i) {
+        lengths[i] += other.lengths[i];
+    }
+    results.merge(other.results);
+    captureMoves += other.captureMoves;
+    capturedPieces += other.capturedPieces;
+    promotions += other.promotions;
+    gamesWithPromotion += other.gamesWithPromotion;
+    damaged += other.damaged;
+    for (const auto& entry : other.openings) {
+        openings[entry.first].merge(entry.second);
+    }
+    for (const auto& entry : other.firstCaptures) {
+        firstCaptures[entry.first] += entry.second;
+    }
+}
+
+void ArchiveStatistics::writeReport(std::ostream& out, int top) const
+{
+    char line[160];
+    out << "Games: " << games << ", plies: " << plies << ", damaged: " << damaged << std::endl;
+    std::snprintf(line, sizeof(line), "Average length: %.1f plies, longest: %u", games ? static_cast<double>(plies) / games : 0.0, longest);
+    out << line << std::endl;
+    std::snprintf(line, sizeof(line), "Results: white %.1f%%, black %.1f%%, draw %.1f%%, unfinished %.1f%%",
+        percent(results.whiteWins, games), percent(results.blackWins, games), percent(results.draws, games),
+        percent(games - results.whiteWins - results.blackWins - results.draws, games));
+    out << line << std::endl;
+    std::snprintf(line, sizeof(line), "Promotions: %.2f per game, in %.1f%% of games", games ? static_cast<double>(promotions) / games : 0.0,
+        percent(gamesWithPromotion, games));
+    out << line << std::endl;
+    std::snprintf(line, sizeof(line), "Captures: %.2f capture moves and %.2f pieces per game",
+        games ? static_cast<double>(captureMoves) / games : 0.0, games ? static_cast<double>(capturedPieces) / games : 0.0);
+    out << line << std::endl;
+
+    out << std::endl << "Length distribution:" << std::endl;
+    uint32_t lower = 0;
+    for (int i = 0; i < lengthBucketCount; ++i) {
+        uint32_t upper = 16u << i;
+        std::string range = std::to_string(lower) + "-" + (i + 1 < lengthBucketCount ? std::to_string(upper - 1) : std::string(""));
+        std::snprintf(line, sizeof(line), "  %-12s %10llu %6.1f%%", range.c_str(), static_cast<unsigned long long>(lengths[i]), percent(lengths[i], games));
+        out << line << std::endl;
+        lower = upper;
+    }
+
+    std::vector<std::pair<std::string, Outcome>> sortedOpenings(openings.begin(), openings.end());
+    std::sort(sortedOpenings.begin(), sortedOpenings.end(), [](const auto& a, const auto& b) {
+        return a.second.games != b.second.games ? a.second.games > b.second.games : a.first < b.first;
+    });
+    out << std::endl << "Most common openings:" << std::endl;
+    std::snprintf(line, sizeof(line), "  %-28s %10s %7s %7s %7s", "moves", "games", "white", "black", "draw");
+    out << line << std::endl;
+    for (size_t i = 0; i < sortedOpenings.size() && i < static_cast<size_t>(top); ++i) {
+        const Outcome& outcome = sortedOpenings[i].second;
+        std::snprintf(line, sizeof(line), "  %-28s %10llu %6.1f%% %6.1f%% %6.1f%%", sortedOpenings[i].first.c_str(),
+            static_cast<unsigned long long>(outcome.games), percent(outcome.whiteWins, outcome.games),
+            percent(outcome.blackWins, outcome.games), percent(outcome.draws, outcome.games));
+        out << line << std::endl;
+    }
+
+    std::vector<std::pair<std::string, uint64_t>> sortedCaptures(firstCaptures.begin(), firstCaptures.end());
+    std::sort(sortedCaptures.begin(), sortedCaptures.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    out << std::endl << "Most common first captures:" << std::endl;
+    for (size_t i = 0; i < sortedCaptures.size() && i < static_cast<size_t>(top); ++i) {
+        std::snprintf(line, sizeof(line), "  %-28s %10llu %6.1f%%", sortedCaptures[i].first.c_str(),
+            static_cast<unsigned long long>(sortedCaptures[i].second), percent(sortedCaptures[i].second, games));
+        out << line << std::endl;
+    }
+}
+
+int runArchiveStats(const StatsConfig& config)
+{
+    std::vector<std::unique_ptr<GameArchive>> archives;
+    std::vector<Chunk> chunks;
+    for (const std::string& path : config.paths) {
+        archives.push_back(std::make_unique<GameArchive>());
+        if (!archives.back()->open(path)) {
+            return 1;
+        }
+        size_t games = archives.back()->gameCount();
+        for (size_t first = 0; first < games; first += config.chunkGames) {
+            chunks.push_back(Chunk{ archives.size() - 1, first, std::min(config.chunkGames, games - first) });
+        }
+    }
+
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<ArchiveStatistics> perThread(static_cast<size_t>(threads));
+    std::atomic<size_t> nextChunk(0);
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            ArchiveStatistics& stats = perThread[static_cast<size_t>(t)];
+            ArchivedGame game; // :       
+            for (size_t index = nextChunk++; index < chunks.size(); index = nextChunk++) {
+                const Chunk& chunk = chunks[index];
+                const GameArchive& archive = *archives[chunk.archive];
+                for (size_t i = chunk.first; i < chunk.first + chunk.count; ++i) {
+                    if (archive.load(i, game)) {
+                        stats.addGame(game, config.openingPlies);
+                    }
+                    else {
+                        ++stats.damaged;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    ArchiveStatistics total;
+    for (const auto& stats : perThread) {
+        total.merge(stats);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    total.writeReport(std::cout, config.top);
+    std::cout << std::endl << config.paths.size() << " archive(s), " << chunks.size() << " chunks, " << threads << " threads: "
+        << seconds << " s, " << static_cast<uint64_t>(total.games / std::max(seconds, 1e-9)) << " games/s, "
+        << static_cast<uint64_t>(total.plies / std::max(seconds, 1e-9)) << " plies/s" << std::endl;
+    return total.damaged == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#ifndef ARCHIVE_STATS_H
+#define ARCHIVE_STATS_H
+
+#include "Archive.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct StatsConfig {
+    std::vector<std::string> paths;
+    int threads = 0;          // 0 -   
+    int openingPlies = 4;     //     
+    int top = 10;             //       
+    size_t chunkGames = 256;  //     
+};
+
+//    .      ,   
+//   merge.      :    
+//       ,   .
+struct ArchiveStatistics {
+    static const int lengthBucketCount = 8; //  : 0-15, 16-31, 32-63, ... 1024-2047, 2048+
+
+    struct Outcome {
+        uint64_t games = 0;
+        uint64_t whiteWins = 0;
+        uint64_t blackWins = 0;
+        uint64_t draws = 0;
+
+        void add(GameState result);
+        void merge(const Outcome& other);
+    };
+
+    uint64_t games = 0;
+    uint64_t plies = 0;
+    uint32_t longest = 0;
+    uint64_t lengths[lengthBucketCount] = {};
+    Outcome results;
+    uint64_t captureMoves = 0;
+    uint64_t capturedPieces = 0;
+    uint64_t promotions = 0;
+    uint64_t gamesWithPromotion = 0;
+    uint64_t damaged = 0;     // ,    
+    std::unordered_map<std::string, Outcome> openings;      //  openingPlies   
+    std::unordered_map<std::string, uint64_t> firstCaptures; //   
+
+    void addGame(const ArchivedGame& game, int openingPlies);
+    void merge(const ArchiveStatistics& other);
+    void writeReport(std::ostream& out, int top) const;
+};
+
+//   :     (GameArchive),   
+//   chunkGames,          
+// MoveGen  .    main.
+int runArchiveStats(const StatsConfig& config);
+
+#endif
@@ -0,0 +1,615 @@
+#include "BatchSimulator.h"
+#include "MoveGen.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+//  ,          SSE2:   
+//  x86-64 (  MSVC  /arch),     .    -
+//      .    : GCC  -O2   
+// ,   -O3    .
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+#ifdef BATCH_SSE2
+struct LaneVector {
+    __m128i v;
+};
+const size_t laneWidth = 4;
+
+inline LaneVector operator&(LaneVector a, LaneVector b) { return { _mm_and_si128(a.v, b.v) }; }
+inline LaneVector operator|(LaneVector a, LaneVector b) { return { _mm_or_si128(a.v, b.v) }; }
+inline LaneVector operator^(LaneVector a, LaneVector b) { return { _mm_xor_si128(a.v, b.v) }; }
+inline LaneVector operator~(LaneVector a) { return { _mm_xor_si128(a.v, _mm_set1_epi32(-1)) }; }
+inline LaneVector operator&(LaneVector a, uint32_t b) { return { _mm_and_si128(a.v, _mm_set1_epi32(static_cast<int>(b))) }; }
+inline LaneVector operator<<(LaneVector a, int bits) { return { _mm_slli_epi32(a.v, bits) }; }
+inline LaneVector operator>>(LaneVector a, int bits) { return { _mm_srli_epi32(a.v, bits) }; }
+inline LaneVector& operator|=(LaneVector& a, LaneVector b) { return a = a | b; }
+inline LaneVector& operator^=(LaneVector& a, LaneVector b) { return a = a ^ b; }
+
+inline LaneVector loadLanes(const uint32_t* in) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)) }; }
+inline void storeLanes(uint32_t* out, LaneVector value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value.v); }
+
+//       :  4x4,  
+//     (out - capture  quiet  , stride -  LaneMoves)
+inline void storeTransposed(const LaneVector masks[4], uint32_t* out, size_t stride) {
+    __m128i low01 = _mm_unpacklo_epi32(masks[0].v, masks[1].v);
+    __m128i low23 = _mm_unpacklo_epi32(masks[2].v, masks[3].v);
+    __m128i high01 = _mm_unpackhi_epi32(masks[0].v, masks[1].v);
+    __m128i high23 = _mm_unpackhi_epi32(masks[2].v, masks[3].v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi64(low01, low23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + stride), _mm_unpackhi_epi64(low01, low23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * stride), _mm_unpacklo_epi64(high01, high23));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 3 * stride), _mm_unpackhi_epi64(high01, high23));
+}
+#else
+using LaneVector = uint32_t;
+const size_t laneWidth = 1;
+
+inline LaneVector loadLanes(const uint32_t* in) { return *in; }
+inline void storeLanes(uint32_t* out, LaneVector value) { *out = value; }
+inline void storeTransposed(const LaneVector masks[4], uint32_t* out, size_t) { std::copy(masks, masks + 4, out); }
+#endif
+
+//           ,  MoveGen::neighbor:
+// 0/1 -  /, 2/3 - .        ,
+//      ;   ,   , .
+const uint32_t evenRows = 0x0F0F0F0Fu;
+const uint32_t oddRows = 0xF0F0F0F0u;
+const uint32_t leftColumn = 0x11111111u & oddRows;   //  0
+const uint32_t rightColumn = 0x88888888u & evenRows; //  7
+
+//   -    : uint32_t     LaneVector
+template <int dir, typename Mask>
+inline Mask shift(Mask mask) {
+    if constexpr (dir == 0) return ((mask & evenRows) << 4) | ((mask & oddRows & ~leftColumn) << 3);
+    else if constexpr (dir == 1) return ((mask & evenRows & ~rightColumn) << 5) | ((mask & oddRows) << 4);
+    else if constexpr (dir == 2) return ((mask & evenRows) >> 4) | ((mask & oddRows & ~leftColumn) >> 5);
+    else return ((mask & evenRows & ~rightColumn) >> 3) | ((mask & oddRows) >> 4);
+}
+
+// ,      dir   mask (  - 3 - dir)
+template <int dir, typename Mask>
+inline Mask behind(Mask mask) {
+    return shift<3 - dir>(mask);
+}
+
+inline uint32_t shiftTo(uint32_t mask, int dir) {
+    switch (dir) {
+    case 0: return shift<0>(mask);
+    case 1: return shift<1>(mask);
+    case 2: return shift<2>(mask);
+    default: return shift<3>(mask);
+    }
+}
+
+inline uint32_t behindTo(uint32_t mask, int dir) {
+    return shiftTo(mask, 3 - dir);
+}
+
+template <PieceColor side>
+constexpr uint32_t promotionRow = (side == PieceColor::WHITE) ? 0xF0000000u : 0x0000000Fu;
+
+// ,      dir.  -   ,    ;
+//  -          (     5).
+template <int dir, typename Mask>
+inline Mask captures(Mask men, Mask flying, Mask enemy, Mask empty) {
+    Mask start = behind<dir>(enemy & behind<dir>(empty));
+    Mask reach = start; // :       
+    reach |= behind<dir>(reach & empty);
+    reach |= behind<dir>(reach & empty);
+    reach |= behind<dir>(reach & empty);
+    reach |= behind<dir>(reach & empty);
+    reach |= behind<dir>(reach & empty);
+    return (men & start) | (flying & reach);
+}
+
+template <typename Mask>
+inline Mask nextRandom(Mask& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//     -  masks:  ,  -  dir
+inline uint32_t pick(const uint32_t masks[4], uint32_t draw, int& dir) {
+    uint32_t counts[4];
+    uint32_t total = 0;
+    for (int i = 0; i < 4; ++i) {
+        counts[i] = static_cast<uint32_t>(std::popcount(masks[i]));
+        total += counts[i];
+    }
+    uint32_t k = static_cast<uint32_t>((static_cast<uint64_t>(draw) * total) >> 32);
+    for (dir = 0; dir < 3 && k >= counts[dir]; ++dir) {
+        k -= counts[dir];
+    }
+    uint32_t mask = masks[dir];
+    for (; k > 0; --k) {
+        mask &= mask - 1;
+    }
+    return mask & (0u - mask);
+}
+
+inline bool any(const uint32_t masks[4]) {
+    return (masks[0] | masks[1] | masks[2] | masks[3]) != 0;
+}
+
+//       - masks: ,  , 
+// ,        . true - masks   
+// ;    ,       .
+template <PieceColor side>
+bool preferQuiet(uint32_t masks[4], uint32_t own, uint32_t enemy, uint32_t kings) {
+    uint32_t empty = ~(own | enemy);
+    uint32_t men = own & ~kings;
+    uint32_t preferred[4];
+    for (int dir = 0; dir < 4; ++dir) {
+        preferred[dir] = masks[dir] & men & behindTo(promotionRow<side>, dir);
+    }
+    if (!any(preferred)) {
+        // ,       . ,  
+        // , ,        .
+        uint32_t attacked = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            attacked |= behindTo(enemy, dir) & shiftTo(empty, dir);
+        }
+        for (int dir = 0; dir < 4; ++dir) {
+            preferred[dir] = masks[dir] & ~behindTo(attacked | behindTo(enemy, dir), dir);
+        }
+    }
+    if (!any(preferred)) {
+        return false;
+    }
+    std::copy(preferred, preferred + 4, masks);
+    return true;
+}
+
+//   from -> to   shift
+inline int directionOf(int from, int to) {
+    return (Position::rowOf(to) < Position::rowOf(from) ? 2 : 0) + (Position::colOf(to) > Position::colOf(from) ? 1 : 0);
+}
+
+//   MoveGen    ,   BatchSimulator:  - ( 
+//  -   ),  ,   ,      .
+//    :      .
+template <PieceColor side>
+const Move& chooseMove(const Position& position, const MoveList& moves, BatchPolicy policy, uint32_t& state) {
+    uint32_t own = side == PieceColor::WHITE ? position.white : position.black;
+    uint32_t enemy = side == PieceColor::WHITE ? position.black : position.white;
+    int candidates[MoveList::capacity];
+    int count = moves.count;
+    for (int i = 0; i < count; ++i) {
+        candidates[i] = i;
+    }
+    bool capture = moves.moves[0].isCapture(); //  :    - ,   
+    for (int depth = 0; count > 1; ++depth) {
+        auto stepFrom = [&moves, depth](int candidate) {
+            const Move& move = moves.moves[candidate];
+            return depth == 0 ? static_cast<int>(move.from) : static_cast<int>(move.path[depth - 1]);
+        };
+        uint32_t masks[4] = {};
+        for (int i = 0; i < count; ++i) {
+            const Move& move = moves.moves[candidates[i]];
+            if (move.pathLength > depth) {
+                masks[directionOf(stepFrom(candidates[i]), move.path[depth])] |= 1u << stepFrom(candidates[i]);
+            }
+        }
+        if (!any(masks)) break;
+        bool oneStep = !capture && policy == BatchPolicy::GREEDY && preferQuiet<side>(masks, own, enemy, position.kings);
+
+        int dir = 0;
+        int from = std::countr_zero(pick(masks, nextRandom(state), dir));
+        int kept = 0;
+        for (int i = 0; i < count; ++i) {
+            const Move& move = moves.moves[candidates[i]];
+            if (move.pathLength > depth && stepFrom(candidates[i]) == from && directionOf(from, move.path[depth]) == dir &&
+                (!oneStep || move.path[depth] == std::countr_zero(shiftTo(1u << from, dir)))) {
+                candidates[kept++] = candidates[i];
+            }
+        }
+        count = kept;
+
+        //  ,   ():    
+        int landings[8];
+        int landingCount = 0;
+        for (int i = 0; i < count; ++i) {
+            int to = moves.moves[candidates[i]].path[depth];
+            if (std::find(landings, landings + landingCount, to) == landings + landingCount) {
+                landings[landingCount++] = to;
+            }
+        }
+        if (landingCount > 1) {
+            int to = landings[(static_cast<uint64_t>(nextRandom(state)) * static_cast<uint32_t>(landingCount)) >> 32];
+            kept = 0;
+            for (int i = 0; i < count; ++i) {
+                if (moves.moves[candidates[i]].path[depth] == to) candidates[kept++] = candidates[i];
+            }
+            count = kept;
+        }
+    }
+    return moves.moves[candidates[0]];
+}
+
+double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * static_cast<double>(part) / static_cast<double>(total) : 0.0;
+}
+
+void printResults(const char* name, const BatchResults& results, double seconds, int threads) {
+    double gamesPerSecond = results.games / std::max(seconds, 1e-9);
+    std::printf("%s: %llu games in %.3f s, %.0f games/s (%.0f per core), %.0f plies/s\n", name,
+        static_cast<unsigned long long>(results.games), seconds, gamesPerSecond, gamesPerSecond / threads,
+        results.plies / std::max(seconds, 1e-9));
+    std::printf("  white %.1f%%, black %.1f%%, unfinished %.1f%%; %.1f plies, %.2f captured, %.2f promotions per game\n",
+        percent(results.whiteWins, results.games), percent(results.blackWins, results.games),
+        percent(results.unfinished, results.games),
+        results.games ? static_cast<double>(results.plies) / results.games : 0.0,
+        results.games ? static_cast<double>(results.capturedPieces) / results.games : 0.0,
+        results.games ? static_cast<double>(results.promotions) / results.games : 0.0);
+}
+
+} // namespace
+
+void BatchResults::merge(const BatchResults& other)
+{
+    games += other.games;
+    whiteWins += other.whiteWins;
+    blackWins += other.blackWins;
+    unfinished += other.unfinished;
+    plies += other.plies;
+    capturedPieces += other.capturedPieces;
+    promotions += other.promotions;
+    mismatches += other.mismatches;
+}
+
+BatchSimulator::BatchSimulator(size_t lanes, BatchPolicy policy, int maxPlies, uint32_t seed) :
+    lanes((std::max<size_t>(lanes, 1) + 7) / 8 * 8), //  8:    
+    policy(policy), maxPlies(std::max(maxPlies, 1)), checkedLanes(0),
+    white(this->lanes), black(this->lanes), kings(this->lanes), jumper(this->lanes), rng(this->lanes),
+    plies(this->lanes), active(this->lanes), moves(this->lanes)
+{
+    uint32_t state = seed ? seed : 1;
+    for (uint32_t& value : rng) {
+        value = nextRandom(state) | 1; //  xorshift  
+    }
+}
+
+template <PieceColor side>
+void BatchSimulator::findMoves()
+{
+    const uint32_t* own = (side == PieceColor::WHITE ? white : black).data();
+    const uint32_t* enemy = (side == PieceColor::WHITE ? black : white).data();
+    const uint32_t* king = kings.data();
+    LaneMoves* found = moves.data();
+
+    const size_t stride = sizeof(LaneMoves) / sizeof(uint32_t);
+
+    for (size_t i = 0; i < lanes; i += laneWidth) {
+        LaneVector ownLanes = loadLanes(own + i);
+        LaneVector enemyLanes = loadLanes(enemy + i);
+        LaneVector kingLanes = loadLanes(king + i);
+        LaneVector empty = ~(ownLanes | enemyLanes);
+        LaneVector men = ownLanes & ~kingLanes;
+        LaneVector flying = ownLanes & kingLanes;
+        LaneVector capture[4] = {
+            captures<0>(men, flying, enemyLanes, empty), captures<1>(men, flying, enemyLanes, empty),
+            captures<2>(men, flying, enemyLanes, empty), captures<3>(men, flying, enemyLanes, empty) };
+        //     :    0/1,   2/3
+        LaneVector up = side == PieceColor::WHITE ? ownLanes : flying;
+        LaneVector down = side == PieceColor::WHITE ? flying : ownLanes;
+        LaneVector quiet[4] = {
+            up & behind<0>(empty), up & behind<1>(empty), down & behind<2>(empty), down & behind<3>(empty) };
+        storeTransposed(capture, found[i].capture, stride);
+        storeTransposed(quiet, found[i].quiet, stride);
+    }
+}
+
+template <PieceColor side>
+bool BatchSimulator::findCaptures(size_t lane)
+{
+    uint32_t own = side == PieceColor::WHITE ? white[lane] : black[lane];
+    uint32_t enemy = side == PieceColor::WHITE ? black[lane] : white[lane];
+    uint32_t empty = ~(own | enemy);
+    uint32_t men = jumper[lane] & ~kings[lane];
+    uint32_t flying = jumper[lane] & kings[lane];
+    LaneMoves& found = moves[lane];
+    found.capture[0] = captures<0>(men, flying, enemy, empty);
+    found.capture[1] = captures<1>(men, flying, enemy, empty);
+    found.capture[2] = captures<2>(men, flying, enemy, empty);
+    found.capture[3] = captures<3>(men, flying, enemy, empty);
+    return any(found.capture);
+}
+
+void BatchSimulator::finishPly(size_t lane, BatchResults& results)
+{
+    ++results.plies;
+    if (++plies[lane] >= static_cast<uint32_t>(maxPlies)) {
+        finishGame(lane, GameState::PLAYING, results);
+    }
+}
+
+void BatchSimulator::finishGame(size_t lane, GameState result, BatchResults& results)
+{
+    active[lane] = 0;
+    jumper[lane] = 0;
+    ++results.games;
+    if (result == GameState::WHITE_WON) ++results.whiteWins;
+    else if (result == GameState::BLACK_WON) ++results.blackWins;
+    else ++results.unfinished;
+}
+
+template <PieceColor side>
+void BatchSimulator::jump(size_t lane, BatchResults& results)
+{
+    int dir = 0;
+    uint32_t from = pick(moves[lane].capture, rng[lane], dir);
+    uint32_t& own = side == PieceColor::WHITE ? white[lane] : black[lane];
+    uint32_t& enemy = side == PieceColor::WHITE ? black[lane] : white[lane];
+    uint32_t empty = ~(own | enemy);
+    bool king = (kings[lane] & from) != 0;
+
+    uint32_t over = shiftTo(from, dir);
+    while (king && (over & empty)) {
+        over = shiftTo(over, dir);
+    }
+    uint32_t to = shiftTo(over, dir);
+    if (king) {
+        //         
+        uint32_t count = 0;
+        for (uint32_t square = to; square & empty; square = shiftTo(square, dir)) {
+            ++count;
+        }
+        for (uint32_t k = static_cast<uint32_t>((static_cast<uint64_t>(nextRandom(rng[lane])) * count) >> 32); k > 0; --k) {
+            to = shiftTo(to, dir);
+        }
+    }
+
+    own ^= from | to;
+    enemy &= ~over;
+    kings[lane] &= ~over;
+    if (king) {
+        kings[lane] ^= from | to;
+    }
+    ++results.capturedPieces;
+    if (!king && (to & promotionRow<side>)) {
+        //   
+        ++results.promotions;
+        jumper[lane] = 0;
+        finishPly(lane, results);
+    }
+    else {
+        jumper[lane] = to; //    ,    
+    }
+}
+
+template <PieceColor side>
+void BatchSimulator::quietMove(size_t lane, BatchResults& results)
+{
+    uint32_t masks[4];
+    std::copy(moves[lane].quiet, moves[lane].quiet + 4, masks);
+    if (!any(masks)) {
+        finishGame(lane, side == PieceColor::WHITE ? GameState::BLACK_WON : GameState::WHITE_WON, results);
+        return;
+    }
+    uint32_t& own = side == PieceColor::WHITE ? white[lane] : black[lane];
+    uint32_t enemy = side == PieceColor::WHITE ? black[lane] : white[lane];
+    uint32_t empty = ~(own | enemy);
+
+    bool oneStep = policy == BatchPolicy::GREEDY && preferQuiet<side>(masks, own, enemy, kings[lane]);
+
+    int dir = 0;
+    uint32_t from = pick(masks, rng[lane], dir);
+    uint32_t to = shiftTo(from, dir);
+    bool king = (kings[lane] & from) != 0;
+    if (king && !oneStep) {
+        uint32_t count = 0;
+        for (uint32_t square = to; square & empty; square = shiftTo(square, dir)) {
+            ++count;
+        }
+        for (uint32_t k = static_cast<uint32_t>((static_cast<uint64_t>(nextRandom(rng[lane])) * count) >> 32); k > 0; --k) {
+            to = shiftTo(to, dir);
+        }
+    }
+    own ^= from | to;
+    if (king) {
+        kings[lane] ^= from | to;
+    }
+    else if (to & promotionRow<side>) {
+        ++results.promotions;
+    }
+    finishPly(lane, results);
+}
+
+template <PieceColor side>
+void BatchSimulator::step(BatchResults& results)
+{
+    std::vector<uint8_t> wasActive;
+    if (checkedLanes > 0) {
+        wasActive.assign(active.begin(), active.begin() + static_cast<std::ptrdiff_t>(checkedLanes));
+        for (size_t i = 0; i < checkedLanes; ++i) {
+            before[i].white = white[i];
+            before[i].black = black[i];
+            before[i].kings = kings[i];
+            before[i].sideToMove = side;
+        }
+    }
+
+    for (size_t i = 0; i < lanes; i += laneWidth) {
+        LaneVector state = loadLanes(&rng[i]);
+        storeLanes(&rng[i], nextRandom(state));
+    }
+    findMoves<side>();
+    series.clear();
+    for (size_t i = 0; i < lanes; ++i) {
+        if (!active[i]) continue;
+        if (any(moves[i].capture)) {
+            jump<side>(i, results); //  
+            if (jumper[i]) series.push_back(static_cast<uint32_t>(i));
+        }
+        else {
+            quietMove<side>(i, results);
+        }
+    }
+
+    //  :     ,    
+    //    ,    ,    
+    while (!series.empty()) {
+        size_t kept = 0;
+        for (uint32_t lane : series) {
+            if (findCaptures<side>(lane)) {
+                nextRandom(rng[lane]);
+                jump<side>(lane, results);
+                if (jumper[lane]) series[kept++] = lane;
+            }
+            else {
+                jumper[lane] = 0;
+                finishPly(lane, results);
+            }
+        }
+        series.resize(kept);
+    }
+
+    // :          
+    const uint32_t* own = (side == PieceColor::WHITE ? white : black).data();
+    uint32_t* king = kings.data();
+    for (size_t i = 0; i < lanes; i += laneWidth) {
+        storeLanes(king + i, loadLanes(king + i) | (loadLanes(own + i) & promotionRow<side>));
+    }
+
+    if (checkedLanes > 0) {
+        checkLanes<side>(wasActive, results);
+    }
+}
+
+template <PieceColor side>
+void BatchSimulator::checkLanes(const std::vector<uint8_t>& wasActive, BatchResults& results)
+{
+    MoveList list;
+    for (size_t i = 0; i < checkedLanes; ++i) {
+        if (!wasActive[i]) continue;
+        Position after;
+        after.white = white[i];
+        after.black = black[i];
+        after.kings = kings[i];
+        after.sideToMove = side;
+        MoveGen::generate(before[i], list);
+        bool found = false;
+        if (after == before[i]) {
+            found = list.count == 0; //    -  
+        }
+        else {
+            after.sideToMove = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+            for (int m = 0; m < list.count && !found; ++m) {
+                found = MoveGen::apply(before[i], list.moves[m]) == after;
+            }
+        }
+        results.mismatches += !found;
+    }
+}
+
+BatchResults BatchSimulator::run(uint64_t games)
+{
+    BatchResults results;
+    before.resize(checkedLanes);
+    std::fill(active.begin(), active.end(), 0);
+    std::fill(jumper.begin(), jumper.end(), 0);
+    uint64_t started = 0;
+    Position initial = Position::initial();
+    while (true) {
+        //   -    ,     
+        bool running = false;
+        for (size_t i = 0; i < lanes; ++i) {
+            if (!active[i] && started < games) {
+                white[i] = initial.white;
+                black[i] = initial.black;
+                kings[i] = initial.kings;
+                plies[i] = 0;
+                active[i] = 1;
+                ++started;
+            }
+            running = running || active[i];
+        }
+        if (!running) break;
+        step<PieceColor::WHITE>(results);
+        step<PieceColor::BLACK>(results);
+    }
+    return results;
+}
+
+BatchResults simulateSequential(uint64_t games, BatchPolicy policy, int maxPlies, uint32_t seed)
+{
+    BatchResults results;
+    uint32_t state = seed ? seed : 1;
+    MoveList moves;
+    for (uint64_t g = 0; g < games; ++g) {
+        Position position = Position::initial();
+        GameState result = GameState::PLAYING;
+        for (int ply = 0; ply < maxPlies; ++ply) {
+            MoveGen::generate(position, moves);
+            if (moves.count == 0) {
+                result = position.sideToMove == PieceColor::WHITE ? GameState::BLACK_WON : GameState::WHITE_WON;
+                break;
+            }
+            const Move& move = position.sideToMove == PieceColor::WHITE ?
+                chooseMove<PieceColor::WHITE>(position, moves, policy, state) :
+                chooseMove<PieceColor::BLACK>(position, moves, policy, state);
+            results.capturedPieces += static_cast<uint64_t>(std::popcount(move.captured));
+            results.promotions += move.promotes;
+            ++results.plies;
+            position = MoveGen::apply(position, move);
+        }
+        ++results.games;
+        if (result == GameState::WHITE_WON) ++results.whiteWins;
+        else if (result == GameState::BLACK_WON) ++results.blackWins;
+        else ++results.unfinished;
+    }
+    return results;
+}
+
+int runBatchSimulation(const BatchConfig& config)
+{
+    int threads = std::max(config.threads, 1);
+    std::vector<BatchResults> perThread(static_cast<size_t>(threads));
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            uint64_t games = config.games / threads + (static_cast<uint64_t>(t) < config.games % threads ? 1 : 0);
+            BatchSimulator simulator(config.lanes, config.policy, config.maxPlies, config.seed + 7919u * static_cast<uint32_t>(t));
+            simulator.setCheckedLanes(config.checkedLanes);
+            perThread[static_cast<size_t>(t)] = simulator.run(games);
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    BatchResults batch;
+    for (const auto& results : perThread) {
+        batch.merge(results);
+    }
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::printf("%s games, %zu lanes x %d thread(s), up to %d plies\n", config.policy == BatchPolicy::GREEDY ? "Greedy" : "Random",
+        (std::max<size_t>(config.lanes, 1) + 7) / 8 * 8, threads, config.maxPlies);
+    printResults("Batch", batch, batchSeconds, threads);
+    if (config.checkedLanes > 0) {
+        std::printf("  checked against MoveGen: %llu mismatches\n", static_cast<unsigned long long>(batch.mismatches));
+    }
+
+    if (config.sequentialGames > 0) {
+        started = std::chrono::steady_clock::now();
+        BatchResults sequential = simulateSequential(config.sequentialGames, config.policy, config.maxPlies, config.seed);
+        double sequentialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        printResults("One by one (MoveGen)", sequential, sequentialSeconds, 1);
+        double batchRate = batch.games / std::max(batchSeconds, 1e-9) / threads;
+        double sequentialRate = sequential.games / std::max(sequentialSeconds, 1e-9);
+        std::printf("Games per second per core: %.1fx\n", batchRate / std::max(sequentialRate, 1e-9));
+    }
+    return batch.mismatches == 0 ? 0 : 1;
+}
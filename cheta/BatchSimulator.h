@@ -0,0 +1,107 @@
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+#include "Enums.h"
+#include "Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//       
+enum class BatchPolicy {
+    RANDOM, //  
+    GREEDY  // ,  ,  ,      ,  
+};
+
+struct BatchResults {
+    uint64_t games = 0;
+    uint64_t whiteWins = 0;
+    uint64_t blackWins = 0;
+    uint64_t unfinished = 0;     //   
+    uint64_t plies = 0;
+    uint64_t capturedPieces = 0;
+    uint64_t promotions = 0;
+    uint64_t mismatches = 0;     //   ,    MoveGen
+
+    void merge(const BatchResults& other);
+};
+
+//       :    ()  ,
+//       ,      .
+//
+//   -    :
+//   1.  :       4    ,
+//          -        SSE2 ( SSE2 -  );
+//   2.  :      (xorshift32,   
+//       ),   -.
+//       ,    : 
+//        .  -     .
+//          .
+//
+//       -,    
+//  MoveGen (  ,  -      ).
+class BatchSimulator {
+public:
+    BatchSimulator(size_t lanes, BatchPolicy policy, int maxPlies, uint32_t seed);
+
+    //  count       MoveGen (,  )
+    void setCheckedLanes(size_t count) { checkedLanes = count < lanes ? count : lanes; }
+
+    //  games        maxPlies 
+    BatchResults run(uint64_t games);
+
+private:
+    size_t lanes;
+    BatchPolicy policy;
+    int maxPlies;
+    size_t checkedLanes;
+
+    std::vector<uint32_t> white;
+    std::vector<uint32_t> black;
+    std::vector<uint32_t> kings;
+    std::vector<uint32_t> jumper;     // ,   ,  0
+    std::vector<uint32_t> rng;
+    std::vector<uint32_t> plies;
+    std::vector<uint8_t> active;
+    //    :    4 .  ,  
+    //     ,        .
+    struct LaneMoves {
+        uint32_t capture[4]; // ,     
+        uint32_t quiet[4];   // ,     
+    };
+    std::vector<LaneMoves> moves;
+    std::vector<Position> before;         //     
+
+    std::vector<uint32_t> series;         // ,     
+
+    template <PieceColor side> void findMoves();
+    template <PieceColor side> bool findCaptures(size_t lane); //   jumper
+    template <PieceColor side> void step(BatchResults& results);
+    template <PieceColor side> void jump(size_t lane, BatchResults& results);
+    template <PieceColor side> void quietMove(size_t lane, BatchResults& results);
+    void finishPly(size_t lane, BatchResults& results);
+    void finishGame(size_t lane, GameState result, BatchResults& results);
+    template <PieceColor side> void checkLanes(const std::vector<uint8_t>& wasActive, BatchResults& results);
+};
+
+//       MoveGen:   .    
+// MoveGen    ,    ( -,    ,
+//  ),       .
+BatchResults simulateSequential(uint64_t games, BatchPolicy policy, int maxPlies, uint32_t seed);
+
+struct BatchConfig {
+    uint64_t games = 100000;
+    size_t lanes = 1024;
+    int maxPlies = 200;
+    BatchPolicy policy = BatchPolicy::RANDOM;
+    uint32_t seed = 1;
+    int threads = 1;              //    ,    
+    uint64_t sequentialGames = 20000; // 0 -  
+    size_t checkedLanes = 0;
+};
+
+//   :          ,  .
+//    main.
+int runBatchSimulation(const BatchConfig& config);
+
+#endif
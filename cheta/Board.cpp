@@ -1,4 +1,6 @@
 #include "Board.h"
+#include "Notation.h"
+#include "Profiler.h"
 #include <stdexcept>
 #include <algorithm>
 
@@ -7,6 +9,7 @@ Board::Board() : board(boardSize, std::vector<Piece*>(boardSize, nullptr)) {
 }
 
 void Board::initialize() {
+	CHETA_PROFILE_SCOPE(INITIALIZE);
 	//  
 	for (int i = 0; i < boardSize; ++i) {
 		for (int j = 0; j < boardSize; ++j) {
@@ -29,7 +32,24 @@ void Board::initialize() {
 	}
 }
 
+bool Board::loadPosition(const std::string& notation, PieceColor* sideToMove) {
+	Position position;
+	if (!Notation::parse(notation, position)) {
+		return false;
+	}
+	position.toBoard(*this);
+	if (sideToMove) {
+		*sideToMove = position.sideToMove;
+	}
+	return true;
+}
+
+std::string Board::toNotation(PieceColor sideToMove) const {
+	return Notation::toString(Position::fromBoard(*this, sideToMove));
+}
+
 Piece* Board::getPiece(int row, int col) const {
+	CHETA_PROFILE_COUNT(GET_PIECE);
 	if (!isInsideBoard(row, col)) {
 		return nullptr;
 	}
@@ -38,6 +58,7 @@ Piece* Board::getPiece(int row, int col) const {
 
 std::optional<PieceColor> Board::getPieceColor(int row, int col) const
 {
+	CHETA_PROFILE_COUNT(GET_PIECE_COLOR);
 	if (!isInsideBoard(row, col)) {
 		return std::nullopt;
 	}
@@ -48,12 +69,21 @@ std::optional<PieceColor> Board::getPieceColor(int row, int col) const
 
 bool Board::isValidMove(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) const
 {
+	if (playerColor == PieceColor::WHITE) return isValidMoveFor<PieceColor::WHITE>(fromRow, fromCol, toRow, toCol);
+	if (playerColor == PieceColor::BLACK) return isValidMoveFor<PieceColor::BLACK>(fromRow, fromCol, toRow, toCol);
+	return false;
+}
+
+template <PieceColor side>
+bool Board::isValidMoveFor(int fromRow, int fromCol, int toRow, int toCol) const
+{
+	CHETA_PROFILE_SCOPE(IS_VALID_MOVE);
 	if (!isInsideBoard(fromRow, fromCol) || !isInsideBoard(toRow, toCol)) {
 		return false;
 	}
 
 	Piece* piece = board[fromRow][fromCol];
-	if (!piece || piece->getColor() != playerColor) {
+	if (!piece || piece->getColor() != side) {
 		return false;  //       
 	}
 
@@ -62,21 +92,30 @@ bool Board::isValidMove(int fromRow, int fromCol, int toRow, int toCol, PieceCol
 	}
 
 	//   .
-	if (hasRequiredJumps(playerColor) && !isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor))
+	if (hasRequiredJumpsFor<side>() && !isJumpPossibleFor<side>(fromRow, fromCol, toRow, toCol))
 	{
 		return false;
 	}
 
 
 	//   
-	return isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor) || isRegularMovePossible(fromRow, fromCol, toRow, toCol, playerColor);
+	return isJumpPossibleFor<side>(fromRow, fromCol, toRow, toCol) || isRegularMovePossibleFor<side>(fromRow, fromCol, toRow, toCol);
 
 }
 
 
-bool Board::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) {
+bool Board::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor)
+{
+	if (playerColor == PieceColor::WHITE) return makeMoveFor<PieceColor::WHITE>(fromRow, fromCol, toRow, toCol);
+	if (playerColor == PieceColor::BLACK) return makeMoveFor<PieceColor::BLACK>(fromRow, fromCol, toRow, toCol);
+	return false;
+}
 
-	if (!isValidMove(fromRow, fromCol, toRow, toCol, playerColor)) {
+template <PieceColor side>
+bool Board::makeMoveFor(int fromRow, int fromCol, int toRow, int toCol) {
+	CHETA_PROFILE_SCOPE(MAKE_MOVE);
+
+	if (!isValidMoveFor<side>(fromRow, fromCol, toRow, toCol)) {
 		return false;
 	}
 
@@ -120,7 +159,8 @@ bool Board::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceColor
 
 
 	//   
-	if ((playerColor == PieceColor::WHITE && toRow == boardSize - 1) || (playerColor == PieceColor::BLACK && toRow == 0))
+	constexpr int promotionRow = (side == PieceColor::WHITE) ? boardSize - 1 : 0;
+	if (toRow == promotionRow)
 	{
 		piece->makeKing();
 	}
@@ -128,18 +168,28 @@ bool Board::makeMove(int fromRow, int fromCol, int toRow, int toCol, PieceColor
 }
 
 bool Board::isInsideBoard(int row, int col) const {
+	CHETA_PROFILE_COUNT(IS_INSIDE_BOARD);
 	return row >= 0 && row < boardSize && col >= 0 && col < boardSize;
 }
 
 
 bool Board::isRegularMovePossible(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) const
 {
+	if (playerColor == PieceColor::WHITE) return isRegularMovePossibleFor<PieceColor::WHITE>(fromRow, fromCol, toRow, toCol);
+	if (playerColor == PieceColor::BLACK) return isRegularMovePossibleFor<PieceColor::BLACK>(fromRow, fromCol, toRow, toCol);
+	return false;
+}
+
+template <PieceColor side>
+bool Board::isRegularMovePossibleFor(int fromRow, int fromCol, int toRow, int toCol) const
+{
+	CHETA_PROFILE_SCOPE(IS_REGULAR_MOVE_POSSIBLE);
 	// 1.  
 	if (!isInsideBoard(toRow, toCol)) {
 		return false; //    
 	}
 	Piece* piece = board[fromRow][fromCol];
-	if (!piece || piece->getColor() != playerColor) {
+	if (!piece || piece->getColor() != side) {
 		return false; //      
 	}
 	if (board[toRow][toCol] != nullptr) {
@@ -170,11 +220,9 @@ bool Board::isRegularMovePossible(int fromRow, int fromCol, int toRow, int toCol
 		// ,    ( 0..2),   (5..7)
 		//       (rowDiff == 1)
 		//       (rowDiff == -1)
-		if (playerColor == PieceColor::WHITE && rowDiff != 1) {
-			return false; //     
-		}
-		if (playerColor == PieceColor::BLACK && rowDiff != -1) {
-			return false; //     
+		constexpr int forward = (side == PieceColor::WHITE) ? 1 : -1;
+		if (rowDiff != forward) {
+			return false; //    
 		}
 		//      
 		return true;
@@ -202,7 +250,16 @@ bool Board::isRegularMovePossible(int fromRow, int fromCol, int toRow, int toCol
 	}
 }
 
-bool Board::isJumpPossible(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) const {
+bool Board::isJumpPossible(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) const
+{
+	if (playerColor == PieceColor::WHITE) return isJumpPossibleFor<PieceColor::WHITE>(fromRow, fromCol, toRow, toCol);
+	if (playerColor == PieceColor::BLACK) return isJumpPossibleFor<PieceColor::BLACK>(fromRow, fromCol, toRow, toCol);
+	return false;
+}
+
+template <PieceColor side>
+bool Board::isJumpPossibleFor(int fromRow, int fromCol, int toRow, int toCol) const {
+	CHETA_PROFILE_SCOPE(IS_JUMP_POSSIBLE);
 
 	//    ,       
 	if (!isInsideBoard(toRow, toCol)) {
@@ -216,7 +273,7 @@ bool Board::isJumpPossible(int fromRow, int fromCol, int toRow, int toCol, Piece
 
 	Piece* piece = board[fromRow][fromCol]; // 'piece'    nullptr    isValidMove,    canJumpFrom
 	//       ,     
-	if (!piece || piece->getColor() != playerColor) {
+	if (!piece || piece->getColor() != side) {
 		return false;
 	}
 
@@ -248,7 +305,7 @@ bool Board::isJumpPossible(int fromRow, int fromCol, int toRow, int toCol, Piece
 			Piece* intermediatePiece = board[currentRow][currentCol];
 			if (intermediatePiece)
 			{
-				if (intermediatePiece->getColor() == playerColor)
+				if (intermediatePiece->getColor() == side)
 				{
 					return false;  //   
 				}
@@ -284,28 +341,37 @@ bool Board::isJumpPossible(int fromRow, int fromCol, int toRow, int toCol, Piece
 		Piece* jumpedPiece = board[jumpedRow][jumpedCol];
 
 		// ,    (  )
-		return jumpedPiece != nullptr && jumpedPiece->getColor() != playerColor;
+		return jumpedPiece != nullptr && jumpedPiece->getColor() != side;
 	}
 }
 
 
 std::vector<std::pair<int, int>> Board::getPossibleMoves(int row, int col, PieceColor playerColor) const
 {
+	if (playerColor == PieceColor::WHITE) return getPossibleMovesFor<PieceColor::WHITE>(row, col);
+	if (playerColor == PieceColor::BLACK) return getPossibleMovesFor<PieceColor::BLACK>(row, col);
+	return {};
+}
+
+template <PieceColor side>
+std::vector<std::pair<int, int>> Board::getPossibleMovesFor(int row, int col) const
+{
+	CHETA_PROFILE_SCOPE(GET_POSSIBLE_MOVES);
 	std::vector<std::pair<int, int>> moves;
-	if (!isInsideBoard(row, col) || getPieceColor(row, col) != playerColor) {
+	if (!isInsideBoard(row, col) || getPieceColor(row, col) != side) {
 		return moves;
 	}
 
-	bool requiredJumps = hasRequiredJumps(playerColor);
+	bool requiredJumps = hasRequiredJumpsFor<side>();
 
 	//   
-	if (!requiredJumps || canJumpFrom(row, col, playerColor)) //   ,   
+	if (!requiredJumps || canJumpFromFor<side>(row, col)) //   ,   
 	{
 		for (int dRow = -2; dRow <= 2; dRow += 4) {
 			for (int dCol = -2; dCol <= 2; dCol += 4) {
 				int newRow = row + dRow;
 				int newCol = col + dCol;
-				if (isJumpPossible(row, col, newRow, newCol, playerColor)) {
+				if (isJumpPossibleFor<side>(row, col, newRow, newCol)) {
 					moves.emplace_back(newRow, newCol);
 				}
 			}
@@ -321,7 +387,7 @@ std::vector<std::pair<int, int>> Board::getPossibleMoves(int row, int col, Piece
 				{
 					int newRow = row + dRow;
 					int newCol = col + dCol;
-					if (isJumpPossible(row, col, newRow, newCol, playerColor))
+					if (isJumpPossibleFor<side>(row, col, newRow, newCol))
 					{
 						moves.emplace_back(newRow, newCol);
 					}
@@ -336,7 +402,7 @@ std::vector<std::pair<int, int>> Board::getPossibleMoves(int row, int col, Piece
 			for (int dCol = -1; dCol <= 1; dCol += 2) {
 				int newRow = row + dRow;
 				int newCol = col + dCol;
-				if (isRegularMovePossible(row, col, newRow, newCol, playerColor)) {
+				if (isRegularMovePossibleFor<side>(row, col, newRow, newCol)) {
 					moves.emplace_back(newRow, newCol);
 				}
 			}
@@ -348,9 +414,18 @@ std::vector<std::pair<int, int>> Board::getPossibleMoves(int row, int col, Piece
 
 bool Board::canJumpFrom(int row, int col, PieceColor playerColor) const
 {
+	if (playerColor == PieceColor::WHITE) return canJumpFromFor<PieceColor::WHITE>(row, col);
+	if (playerColor == PieceColor::BLACK) return canJumpFromFor<PieceColor::BLACK>(row, col);
+	return false;
+}
+
+template <PieceColor side>
+bool Board::canJumpFromFor(int row, int col) const
+{
+	CHETA_PROFILE_SCOPE(CAN_JUMP_FROM);
 	Piece* piece = board[row][col];
 	//      ,    nullptr
-	if (!piece || piece->getColor() != playerColor) {
+	if (!piece || piece->getColor() != side) {
 		return false;
 	}
 
@@ -373,7 +448,7 @@ bool Board::canJumpFrom(int row, int col, PieceColor playerColor) const
 					Piece* checkPiece = board[checkRow][checkCol];
 
 					if (checkPiece) { //    
-						if (checkPiece->getColor() != playerColor) { //   
+						if (checkPiece->getColor() != side) { //   
 							//     
 							int jumpToRow = checkRow + dr;
 							int jumpToCol = checkCol + dc;
@@ -381,7 +456,7 @@ bool Board::canJumpFrom(int row, int col, PieceColor playerColor) const
 							if (isInsideBoard(jumpToRow, jumpToCol) && board[jumpToRow][jumpToCol] == nullptr) {
 								// ,          
 								// (isJumpPossible   )
-								if (isJumpPossible(row, col, jumpToRow, jumpToCol, playerColor)) {
+								if (isJumpPossibleFor<side>(row, col, jumpToRow, jumpToCol)) {
 									return true;
 								}
 								//       (,    ),
@@ -417,7 +492,7 @@ bool Board::canJumpFrom(int row, int col, PieceColor playerColor) const
 				}
 
 				//   isJumpPossible    newRow, newCol
-				if (isJumpPossible(row, col, newRow, newCol, playerColor)) {
+				if (isJumpPossibleFor<side>(row, col, newRow, newCol)) {
 					return true;
 				}
 			}
@@ -427,13 +502,22 @@ bool Board::canJumpFrom(int row, int col, PieceColor playerColor) const
 }
 
 
-std::vector<std::pair<int, int>> Board::getRequiredJumps(PieceColor playerColor) const {
+std::vector<std::pair<int, int>> Board::getRequiredJumps(PieceColor playerColor) const
+{
+	if (playerColor == PieceColor::WHITE) return getRequiredJumpsFor<PieceColor::WHITE>();
+	if (playerColor == PieceColor::BLACK) return getRequiredJumpsFor<PieceColor::BLACK>();
+	return {};
+}
+
+template <PieceColor side>
+std::vector<std::pair<int, int>> Board::getRequiredJumpsFor() const {
+	CHETA_PROFILE_SCOPE(GET_REQUIRED_JUMPS);
 	std::vector<std::pair<int, int>> jumpPositions;
 	for (int row = 0; row < boardSize; ++row)
 	{
 		for (int col = 0; col < boardSize; ++col)
 		{
-			if (getPieceColor(row, col) == playerColor && canJumpFrom(row, col, playerColor))
+			if (canJumpFromFor<side>(row, col)) // canJumpFrom    
 			{
 				jumpPositions.emplace_back(row, col);
 			}
@@ -444,11 +528,32 @@ std::vector<std::pair<int, int>> Board::getRequiredJumps(PieceColor playerColor)
 
 bool Board::hasRequiredJumps(PieceColor playerColor) const
 {
-	return !getRequiredJumps(playerColor).empty();
+	if (playerColor == PieceColor::WHITE) return hasRequiredJumpsFor<PieceColor::WHITE>();
+	if (playerColor == PieceColor::BLACK) return hasRequiredJumpsFor<PieceColor::BLACK>();
+	return false;
+}
+
+template <PieceColor side>
+bool Board::hasRequiredJumpsFor() const
+{
+	CHETA_PROFILE_SCOPE(HAS_REQUIRED_JUMPS);
+	//   ,   :   
+	for (int row = 0; row < boardSize; ++row)
+	{
+		for (int col = (row % 2 == 0) ? 1 : 0; col < boardSize; col += 2)
+		{
+			if (canJumpFromFor<side>(row, col))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
 }
 
 //     ,      .
 void Board::removePiece(int row, int col) {
+	CHETA_PROFILE_SCOPE(REMOVE_PIECE);
 	if (isInsideBoard(row, col)) {
 		delete board[row][col]; //  -   
 		board[row][col] = nullptr;
@@ -456,6 +561,7 @@ void Board::removePiece(int row, int col) {
 }
 
 void Board::setPiece(int row, int col, Piece* piece) {
+	CHETA_PROFILE_SCOPE(SET_PIECE);
 	if (isInsideBoard(row, col)) {
 		// delete board[row][col]; // ! !
 		board[row][col] = piece;
@@ -465,6 +571,7 @@ void Board::setPiece(int row, int col, Piece* piece) {
 //       nullptr.
 //    ,   .
 void Board::clearPiece(int row, int col) {
+	CHETA_PROFILE_SCOPE(CLEAR_PIECE);
 	if (isInsideBoard(row, col)) {
 		// delete board[row][col]; // ! !
 		board[row][col] = nullptr;
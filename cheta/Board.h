@@ -4,6 +4,7 @@
 #include "Piece.h"
 #include <vector>
 #include <optional>
+#include <string>
 #include "Enums.h"
 
 class Board {
@@ -12,6 +13,9 @@ public:
 	~Board();
 
 	void initialize(); //     
+	//    FEN   Hub (. Notation.h).   false,   .
+	bool loadPosition(const std::string& notation, PieceColor* sideToMove = nullptr);
+	std::string toNotation(PieceColor sideToMove) const;
 	Piece* getPiece(int row, int col) const; //    .   nullptr,   .
 	std::optional<PieceColor> getPieceColor(int row, int col) const;
 
@@ -39,6 +43,18 @@ private:
 	
 	bool isRegularMovePossible(int fromRow, int fromCol, int toRow, int toCol, PieceColor playerColor) const;
 
+	// ,    :  ,  
+	//    -   .    
+	//  ,          .
+	template <PieceColor side> bool isValidMoveFor(int fromRow, int fromCol, int toRow, int toCol) const;
+	template <PieceColor side> bool makeMoveFor(int fromRow, int fromCol, int toRow, int toCol);
+	template <PieceColor side> bool isRegularMovePossibleFor(int fromRow, int fromCol, int toRow, int toCol) const;
+	template <PieceColor side> bool isJumpPossibleFor(int fromRow, int fromCol, int toRow, int toCol) const;
+	template <PieceColor side> std::vector<std::pair<int, int>> getPossibleMovesFor(int row, int col) const;
+	template <PieceColor side> bool canJumpFromFor(int row, int col) const;
+	template <PieceColor side> std::vector<std::pair<int, int>> getRequiredJumpsFor() const;
+	template <PieceColor side> bool hasRequiredJumpsFor() const;
+
 	
 };
 
@@ -19,4 +19,25 @@ enum class GameState {
     DRAW
 };
 
+//     (  )
+enum class MoveResult {
+    INVALID,        //  ,   
+    JUMP_CONTINUES, //  ,      
+    TURN_FINISHED   //  ,    
+};
+
+//    (StepResult::error -   )
+enum class StepRejection {
+    NONE,
+    GAME_OVER,      //   
+    CONTINUATION,   //         
+    JUMP_REQUIRED,  //   ,   -  
+    WRONG_JUMPER,   //    
+    BAD_JUMP,       //  
+    OUT_OF_BOUNDS,  //   
+    NOT_OWN_PIECE,  //     
+    OCCUPIED,       //   
+    ILLEGAL         //    (  ,    ..)
+};
+
 #endif
\ No newline at end of file
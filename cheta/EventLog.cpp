@@ -0,0 +1,307 @@
+#include "EventLog.h"
+#include "Game.h"
+#include "LatencyHistogram.h"
+#include "MoveGen.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+
+namespace {
+
+const char* rejectionName(uint8_t reason) {
+    switch (static_cast<StepRejection>(reason)) {
+    case StepRejection::GAME_OVER: return "game-over";
+    case StepRejection::CONTINUATION: return "continuation";
+    case StepRejection::JUMP_REQUIRED: return "jump-required";
+    case StepRejection::WRONG_JUMPER: return "wrong-jumper";
+    case StepRejection::BAD_JUMP: return "bad-jump";
+    case StepRejection::OUT_OF_BOUNDS: return "out-of-bounds";
+    case StepRejection::NOT_OWN_PIECE: return "not-own-piece";
+    case StepRejection::OCCUPIED: return "occupied";
+    case StepRejection::ILLEGAL: return "illegal";
+    default: return "unknown";
+    }
+}
+
+char stateChar(uint8_t state) {
+    switch (static_cast<GameState>(state)) {
+    case GameState::WHITE_WON: return 'W';
+    case GameState::BLACK_WON: return 'B';
+    case GameState::DRAW: return 'D';
+    default: return 'P';
+    }
+}
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void appendLine(const GameEvent& event, std::string& out) {
+    out += std::to_string(event.timeNs / 1000);
+    out += ' ';
+    EventLog::format(event, out);
+    out += '\n';
+}
+
+} // namespace
+
+EventRing::EventRing(size_t capacity) :
+    slots(nextPowerOfTwo(std::max<size_t>(capacity, 2))), mask(slots.size() - 1),
+    head(0), cachedTail(0), overflow(0), tail(0)
+{
+}
+
+bool EventRing::push(const GameEvent& event)
+{
+    uint64_t position = head.load(std::memory_order_relaxed);
+    if (position - cachedTail > mask) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (position - cachedTail > mask) {
+            //    - ,    
+            overflow.store(overflow.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    slots[position & mask] = event;
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+size_t EventRing::drain(std::vector<GameEvent>& out)
+{
+    uint64_t first = tail.load(std::memory_order_relaxed);
+    uint64_t last = head.load(std::memory_order_acquire);
+    for (uint64_t position = first; position != last; ++position) {
+        out.push_back(slots[position & mask]);
+    }
+    tail.store(last, std::memory_order_release); //     
+    return static_cast<size_t>(last - first);
+}
+
+EventLog::~EventLog()
+{
+    close();
+}
+
+bool EventLog::open(const std::string& path)
+{
+    if (path == "-") {
+        file = stdout;
+        ownsFile = false;
+    }
+    else {
+        file = std::fopen(path.c_str(), "ab");
+        if (!file) {
+            std::cerr << "Cannot open event log " << path << std::endl;
+            return false;
+        }
+        ownsFile = true;
+    }
+    stopping = false;
+    writer = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+void EventLog::close()
+{
+    if (!writer.joinable()) {
+        return;
+    }
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    if (ownsFile) {
+        std::fclose(file);
+    }
+    file = nullptr;
+}
+
+std::shared_ptr<EventRing> EventLog::attach(size_t capacity)
+{
+    auto ring = std::make_shared<EventRing>(capacity);
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    rings.push_back(ring);
+    return ring;
+}
+
+uint64_t EventLog::dropped() const
+{
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    uint64_t total = 0;
+    for (const auto& ring : rings) {
+        total += ring->dropped();
+    }
+    return total;
+}
+
+void EventLog::format(const GameEvent& event, std::string& out)
+{
+    char text[96];
+    int length = std::snprintf(text, sizeof(text), "%u %u ", event.gameId, event.ply);
+    out.append(text, static_cast<size_t>(std::max(length, 0)));
+    switch (event.type) {
+    case GameEventType::TURN:
+        out += "turn ";
+        for (uint8_t i = 0; i < event.squareCount; ++i) {
+            if (i > 0) out += event.detail ? 'x' : '-';
+            out += std::to_string(event.squares[i] + 1);
+        }
+        break;
+    case GameEventType::CAPTURE:
+        out += "capture " + std::to_string(event.squares[0] + 1);
+        break;
+    case GameEventType::PROMOTION:
+        out += "promote " + std::to_string(event.squares[0] + 1);
+        break;
+    case GameEventType::REJECTED:
+        length = std::snprintf(text, sizeof(text), "reject (%d,%d)-(%d,%d) %s", event.step[0], event.step[1],
+            event.step[2], event.step[3], rejectionName(event.detail));
+        out.append(text, static_cast<size_t>(std::max(length, 0)));
+        break;
+    case GameEventType::GAME_OVER:
+        out += "over ";
+        out += stateChar(event.detail);
+        break;
+    }
+}
+
+bool EventLog::writeBatch(std::vector<GameEvent>& events, std::string& text, uint64_t& reportedDrops)
+{
+    events.clear();
+    uint64_t drops = 0;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const auto& ring : rings) {
+            ring->drain(events);
+            drops += ring->dropped();
+        }
+    }
+    if (events.empty() && drops == reportedDrops) {
+        return false;
+    }
+    //      ,   -   
+    std::stable_sort(events.begin(), events.end(), [](const GameEvent& a, const GameEvent& b) { return a.timeNs < b.timeNs; });
+    text.clear();
+    for (const GameEvent& event : events) {
+        appendLine(event, text);
+    }
+    if (drops != reportedDrops) {
+        text += "# dropped " + std::to_string(drops - reportedDrops) + " events\n";
+        reportedDrops = drops;
+    }
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fflush(file); //    ,    
+    writtenEvents.fetch_add(events.size(), std::memory_order_relaxed);
+    return true;
+}
+
+void EventLog::writerLoop()
+{
+    std::vector<GameEvent> events;
+    std::string text;
+    uint64_t reportedDrops = 0;
+    while (true) {
+        //    :  close    ,   
+        //  ,    
+        bool last = stopping.load(std::memory_order_acquire);
+        bool wrote = writeBatch(events, text, reportedDrops);
+        if (last) {
+            return;
+        }
+        if (!wrote) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+namespace {
+
+enum class BenchOutput { NONE, SYNC, RING };
+
+//    Game::applyStep;        
+void playBenchGames(BenchOutput output, const std::string& path, int games, size_t ringCapacity,
+    LatencyHistogram& latency, uint64_t& steps, uint64_t& dropped, double& seconds)
+{
+    EventLog log;
+    std::ofstream sync;
+    std::shared_ptr<EventRing> ring;
+    std::vector<GameEvent> pending;
+    std::string line;
+    if (output == BenchOutput::RING) {
+        if (!log.open(path)) return;
+        ring = log.attach(ringCapacity);
+    }
+    else if (output == BenchOutput::SYNC) {
+        sync.open(path, std::ios::app);
+        ring = std::make_shared<EventRing>(64); //    
+    }
+
+    std::mt19937 rng(1);
+    MoveList moves;
+    steps = 0;
+    auto started = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; ++g) {
+        Game game(new RemotePlayer("White", PieceColor::WHITE), new RemotePlayer("Black", PieceColor::BLACK));
+        game.setEventLog(ring, static_cast<uint32_t>(g + 1));
+        for (int turn = 0; turn < 200 && !game.isGameOver(); ++turn) {
+            MoveGen::generate(Position::fromBoard(game.getBoard(), game.getCurrentPlayerColor()), moves);
+            if (moves.count == 0) break;
+            const Move& move = moves.moves[std::uniform_int_distribution<int>(0, moves.count - 1)(rng)];
+            //     :   (0,0)   
+            int stops = (turn % 8 == 0) ? -1 : 0;
+            for (int i = stops; i < move.pathLength; ++i) {
+                int from = i <= 0 ? move.from : move.path[i - 1];
+                int to = i < 0 ? move.path[0] : move.path[i];
+                int fromRow = i < 0 ? 0 : Position::rowOf(from);
+                int fromCol = i < 0 ? 0 : Position::colOf(from);
+                auto stepStarted = std::chrono::steady_clock::now();
+                game.applyStep(fromRow, fromCol, Position::rowOf(to), Position::colOf(to));
+                if (output == BenchOutput::SYNC) {
+                    //  :   ,    
+                    pending.clear();
+                    ring->drain(pending);
+                    for (const GameEvent& event : pending) {
+                        line.clear();
+                        appendLine(event, line);
+                        line.pop_back();
+                        sync << line << std::endl;
+                    }
+                }
+                latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - stepStarted).count()));
+                ++steps;
+            }
+        }
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    dropped = ring ? ring->dropped() : 0;
+    log.close();
+}
+
+} // namespace
+
+int runEventLogBench(const std::string& path, int games, size_t ringCapacity)
+{
+    const struct {
+        BenchOutput output;
+        const char* name;
+    } variants[] = { { BenchOutput::NONE, "no events" }, { BenchOutput::SYNC, "sync endl" }, { BenchOutput::RING, "event ring" } };
+    std::remove(path.c_str());
+    std::printf("%-12s %10s %10s %10s %10s %10s %10s\n", "output", "steps", "seconds", "p50 us", "p99 us", "p99.9 us", "dropped");
+    for (const auto& variant : variants) {
+        uint64_t steps = 0, dropped = 0;
+        double seconds = 0;
+        auto latency = std::make_unique<LatencyHistogram>(); //   -   
+        playBenchGames(variant.output, path, games, ringCapacity, *latency, steps, dropped, seconds);
+        std::printf("%-12s %10llu %10.3f %10.2f %10.2f %10.2f %10llu\n", variant.name, static_cast<unsigned long long>(steps), seconds,
+            latency->percentile(50) / 1000.0, latency->percentile(99) / 1000.0, latency->percentile(99.9) / 1000.0,
+            static_cast<unsigned long long>(dropped));
+    }
+    return 0;
+}
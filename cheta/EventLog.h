@@ -0,0 +1,109 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "Enums.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum class GameEventType : uint8_t {
+    TURN,      //  : squares -     , detail - 1  
+    CAPTURE,   //  : squares[0]
+    PROMOTION, //   : squares[0]
+    REJECTED,  //  : step -   , detail - StepRejection
+    GAME_OVER  // detail - GameState
+};
+
+//    :    ,   
+//     .    .
+struct GameEvent {
+    uint64_t timeNs = 0;     // steady_clock
+    uint32_t gameId = 0;
+    uint32_t ply = 0;        //   ( ),    
+    GameEventType type = GameEventType::TURN;
+    uint8_t detail = 0;
+    uint8_t squareCount = 0;
+    int8_t step[4] = {};     // fromRow, fromCol, toRow, toCol
+    uint8_t squares[14] = {}; //  0..31,   Position
+};
+
+static_assert(std::is_trivially_copyable<GameEvent>::value, "GameEvent is copied into the ring");
+
+//    - (SPSC).    : 
+//       ,      dropped.
+// head  tail     ;     tail
+//   ,     .
+class EventRing {
+public:
+    explicit EventRing(size_t capacity); //     
+
+    bool push(const GameEvent& event);      //  -
+    size_t drain(std::vector<GameEvent>& out); //   :   out  
+    uint64_t dropped() const { return overflow.load(std::memory_order_relaxed); }
+    size_t capacity() const { return mask + 1; }
+
+private:
+    std::vector<GameEvent> slots;
+    size_t mask;
+    alignas(64) std::atomic<uint64_t> head; //  ,  
+    uint64_t cachedTail;                    //  tail  
+    std::atomic<uint64_t> overflow;
+    alignas(64) std::atomic<uint64_t> tail; //  ,   
+};
+
+//   :    ,    ,   ,
+//      ,       fwrite  .
+//        .
+//
+// : <> <> <> <>, 
+//   1843021 7 12 turn 9x18x27
+//   1843020 7 12 capture 14
+//   1843100 7 13 reject (2,1)-(3,0) jump-required
+//   1843200 7 40 over W
+//    - ,   "# dropped N events".
+class EventLog {
+public:
+    static const size_t defaultRingCapacity = 4096;
+
+    EventLog() = default;
+    ~EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    bool open(const std::string& path); // "-" - stdout. false   ( )
+    void close();                       //      
+
+    //    -.     ,   
+    //   ;  ,     .
+    std::shared_ptr<EventRing> attach(size_t capacity = defaultRingCapacity);
+
+    uint64_t written() const { return writtenEvents.load(std::memory_order_relaxed); }
+    uint64_t dropped() const;
+
+    //        (    )
+    static void format(const GameEvent& event, std::string& out);
+
+private:
+    std::FILE* file = nullptr;
+    bool ownsFile = false;
+    std::thread writer;
+    std::atomic<bool> stopping{ false };
+    mutable std::mutex ringsMutex; //  attach   ,    
+    std::vector<std::shared_ptr<EventRing>> rings;
+    std::atomic<uint64_t> writtenEvents{ 0 };
+
+    void writerLoop();
+    bool writeBatch(std::vector<GameEvent>& events, std::string& text, uint64_t& reportedDrops);
+};
+
+//    (Game::applyStep)  ,      
+//   std::endl   EventLog:     .    main.
+int runEventLogBench(const std::string& path, int games, size_t ringCapacity);
+
+#endif
@@ -1,9 +1,20 @@
 #include "Game.h"
+#include "MoveGen.h"
+#include "Notation.h"
+#include "Profiler.h"
+#include "Renderer.h"
 #include <iostream>
 #include <cstdlib>
-
-Game::Game(Player* player1, Player* player2, bool whiteStarts) :
-    currentPlayerIndex(0), gameState(GameState::PLAYING), whiteStarts(whiteStarts)
+#include <algorithm>
+#include <limits>
+#include <chrono>
+
+Game::Game(Player* player1, Player* player2, bool whiteStarts, std::shared_ptr<SnapshotSlot> snapshots) :
+    currentPlayerIndex(0), gameState(GameState::PLAYING), whiteStarts(whiteStarts),
+    jumpRow(-1), jumpCol(-1), lastFromRow(-1), lastFromCol(-1), lastToRow(-1), lastToCol(-1),
+    ply(0),
+    snapshots(snapshots ? std::move(snapshots) : std::make_shared<SnapshotSlot>()),
+    eventGameId(0)
 {
     players.push_back(player1);
     players.push_back(player2);
@@ -11,6 +22,8 @@ Game::Game(Player* player1, Player* player2, bool whiteStarts) :
     if (!whiteStarts) {
         currentPlayerIndex = 1; //  ,  whiteStarts == false
     }
+    turnSquares.reserve(14); //  12     :    
+    publishSnapshot(false);
 }
 
 Game::~Game()
@@ -20,103 +33,63 @@ Game::~Game()
     }
 }
 
-void Game::printBoard() const {
-    int size = board.getBoardSize();
-    //   
-    std::cout << "  "; //    
-    for (int j = 0; j < size; ++j) {
-        std::cout << j << " ";
+BoardHighlights Game::getHighlights() const {
+    BoardHighlights highlights;
+    if (lastFromRow != -1) {
+        highlights.lastMove = (1ull << (lastFromRow * 8 + lastFromCol)) | (1ull << (lastToRow * 8 + lastToCol));
     }
-    std::cout << std::endl;
-
-    for (int i = 0; i < size; ++i) {
-        std::cout << i << " "; //   
-        for (int j = 0; j < size; ++j) {
-            //  i  j , ..     
-            Piece* piece = board.getPiece(i, j); //  getPiece
-            if (piece) { //    
-                PieceColor color = piece->getColor();
-                bool isKing = piece->isKing();
-                if (color == PieceColor::WHITE) {
-                    std::cout << (isKing ? "W " : "w ");
-                }
-                else { // BLACK
-                    std::cout << (isKing ? "B " : "b ");
-                }
-            }
-            else { //  
-                //  '-'  '.',      
-                std::cout << (((i + j) % 2 == 0) ? ". " : "- "); //     
-                //  : std::cout << ". ";
-            }
-        }
-        std::cout << i; //   
-        std::cout << std::endl;
+    if (isGameOver()) {
+        return highlights;
     }
-    //    
-    std::cout << "  ";
-    for (int j = 0; j < size; ++j) {
-        std::cout << j << " ";
+    //   :     (  -    )
+    Position position = Position::fromBoard(board, getCurrentPlayerColor());
+    MoveList moves;
+    MoveGen::generate(position, moves);
+    int jumpSquare = jumpRow != -1 ? Position::square(jumpRow, jumpCol) : -1;
+    for (int i = 0; i < moves.count; ++i) {
+        const Move& move = moves.moves[i];
+        if (jumpSquare != -1 && move.from != jumpSquare) continue;
+        int to = move.path[0];
+        highlights.destinations |= 1ull << (Position::rowOf(to) * 8 + Position::colOf(to));
     }
-    std::cout << std::endl;
+    return highlights;
+}
+
+void Game::redraw(const std::string& status) {
+    if (!renderer) {
+        renderer = std::make_unique<TerminalRenderer>();
+    }
+    renderer->render(board, getHighlights(), status, message);
 }
 
 
 void Game::start() {
+    if (renderer) {
+        renderer->invalidate(); //    
+    }
+    message.clear();
     while (!isGameOver()) {
+        //   (     ).
+        // applyStep          .
+        makePlayerMove();
+    }
 
-        // ---   ---
-#ifdef _WIN32 //   Windows (   MSVC)
-        system("cls");
-#endif
-        // ------------------------
-
-        //    
-        std::cout << "\nCurrent Board:" << std::endl;
-        printBoard(); //    
-        std::cout << "Current Player: " << players[currentPlayerIndex]->getName()
-            << " (" << (getCurrentPlayerColor() == PieceColor::WHITE ? "White" : "Black") << ")" << std::endl;
-
-        bool moveResult = makePlayerMove(); //   (    ..)
-
-        //  makePlayerMove  false (  ), checkGameEnd  
-        if (!moveResult && !isGameOver()) { //  !isGameOver()   
-            //   ,  
-            // std::cout << "No moves were made." << std::endl;
-        }
-
-        //      
-        if (checkGameEnd()) {
-            break; //     
-        }
-
-        //       
-        switchPlayer();
-
-    } //  while (!isGameOver())
-
-#ifdef _WIN32
-    system("cls");
-#else
-    system("clear");
-#endif
-
-    std::cout << "\n--- Game Over ---" << std::endl;
-    printBoard(); //   
     switch (gameState) {
     case GameState::WHITE_WON:
-        std::cout << "White won!" << std::endl;
+        message = "White won!";
         break;
     case GameState::BLACK_WON:
-        std::cout << "Black won!" << std::endl;
+        message = "Black won!";
         break;
     case GameState::DRAW: //    ,   
-        std::cout << "Draw!" << std::endl;
+        message = "Draw!";
         break;
     default:
-        std::cout << "Game finished unexpectedly." << std::endl;
+        message = "Game finished unexpectedly.";
         break;
     }
+    redraw("--- Game Over ---"); //   
+    std::cout << std::endl;
 }
 
 
@@ -141,21 +114,19 @@ bool isPositionInList(int r, int c, const std::vector<std::pair<int, int>>& list
 bool Game::makePlayerMove()
 {
     Player* currentPlayer = players[currentPlayerIndex];
-    PieceColor playerColor = currentPlayer->getColor();
-    bool turnFinished = false; // :      
-    int currentPieceRow = -1, currentPieceCol = -1; //     
 
-    //    . ,     (turnFinished = true).
-    while (!turnFinished) {
+    //    . ,     .
+    while (true) {
+        redraw("Current Player: " + currentPlayer->getName() +
+            " (" + (getCurrentPlayerColor() == PieceColor::WHITE ? "White" : "Black") + ")");
 
         int fromRow, fromCol, toRow, toCol;
-        bool isContinuationJump = (currentPieceRow != -1);
 
         // 1.    
-        if (isContinuationJump) {
+        if (jumpRow != -1) {
             //       
-            fromRow = currentPieceRow;
-            fromCol = currentPieceCol;
+            fromRow = jumpRow;
+            fromCol = jumpCol;
             std::cout << currentPlayer->getName() << ", continue jump from (" << fromRow << "," << fromCol << ") (enter toRow toCol): ";
             int nextToRow, nextToCol;
             while (!(std::cin >> nextToRow >> nextToCol)) { //     
@@ -177,128 +148,244 @@ bool Game::makePlayerMove()
             toCol = move.second.second;
         }
 
-        // 2.  /    
-        bool isValidAction = false; //    
-        bool isAttemptedJump = std::abs(toRow - fromRow) >= 2;
-        auto requiredJumpsInfo = board.getRequiredJumps(playerColor); // ,   
-        bool mustJumpGenerally = !requiredJumpsInfo.empty();          //     
+        // 2.    
+        StepResult step = applyStep(fromRow, fromCol, toRow, toCol);
+        if (step.result == MoveResult::INVALID) {
+            message = step.error;
+            continue; //      
+        }
+        message = step.promoted ? "Piece promoted to King!" : "";
+        if (step.result == MoveResult::JUMP_CONTINUES) {
+            message = "Another jump possible/required from (" + std::to_string(toRow) + "," + std::to_string(toCol) + ").";
+            continue; //        
+        }
+        return true; //  
+    }
+}
+
+StepResult Game::applyStep(int fromRow, int fromCol, int toRow, int toCol)
+{
+    uint32_t turn = ply + 1; // ,    (  ply  )
+    StepResult step = performStep(fromRow, fromCol, toRow, toCol);
+    if (events) {
+        emitStepEvents(step, fromRow, fromCol, toRow, toCol, turn);
+    }
+    return step;
+}
 
-        if (isContinuationJump) { // ---    ---
-            //   ,        
-            if (isAttemptedJump && board.isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor)) {
-                isValidAction = true;
+void Game::setEventLog(std::shared_ptr<EventRing> ring, uint32_t gameId)
+{
+    events = std::move(ring);
+    eventGameId = gameId;
+}
+
+void Game::emitStepEvents(const StepResult& step, int fromRow, int fromCol, int toRow, int toCol, uint32_t turn)
+{
+    GameEvent event;
+    event.timeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    event.gameId = eventGameId;
+    event.ply = turn;
+
+    if (step.result == MoveResult::INVALID) {
+        event.type = GameEventType::REJECTED;
+        event.detail = static_cast<uint8_t>(step.reason);
+        int coordinates[4] = { fromRow, fromCol, toRow, toCol };
+        for (int i = 0; i < 4; ++i) {
+            event.step[i] = static_cast<int8_t>(std::clamp(coordinates[i], -128, 127)); //    
+        }
+        events->push(event);
+        return;
+    }
+    if (step.captured) {
+        event.type = GameEventType::CAPTURE;
+        event.squareCount = 1;
+        event.squares[0] = static_cast<uint8_t>(Position::square(step.capturedRow, step.capturedCol));
+        events->push(event);
+    }
+    if (step.promoted) {
+        event.type = GameEventType::PROMOTION;
+        event.squareCount = 1;
+        event.squares[0] = static_cast<uint8_t>(Position::square(toRow, toCol));
+        events->push(event);
+    }
+    if (step.result == MoveResult::TURN_FINISHED) {
+        event.type = GameEventType::TURN;
+        event.detail = step.captured ? 1 : 0; //    - ,  
+        event.squareCount = static_cast<uint8_t>(std::min<size_t>(turnSquares.size(), sizeof(event.squares)));
+        for (uint8_t i = 0; i < event.squareCount; ++i) {
+            event.squares[i] = static_cast<uint8_t>(turnSquares[i]);
+        }
+        events->push(event);
+        if (isGameOver()) {
+            event.type = GameEventType::GAME_OVER;
+            event.squareCount = 0;
+            event.detail = static_cast<uint8_t>(gameState);
+            events->push(event);
+        }
+    }
+}
+
+StepResult Game::performStep(int fromRow, int fromCol, int toRow, int toCol)
+{
+    CHETA_PROFILE_SCOPE(APPLY_STEP);
+    StepResult step;
+    if (isGameOver()) {
+        step.error = "Game is over.";
+        step.reason = StepRejection::GAME_OVER;
+        return step;
+    }
+
+    PieceColor playerColor = getCurrentPlayerColor();
+    bool isContinuationJump = (jumpRow != -1);
+    bool isAttemptedJump = std::abs(toRow - fromRow) >= 2;
+
+    // 1.  /    
+    if (isContinuationJump) { // ---    ---
+        //      ,        
+        if (fromRow != jumpRow || fromCol != jumpCol || !isAttemptedJump ||
+            !board.isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor)) {
+            step.error = "Invalid continuation jump. You must make a valid jump from (" +
+                std::to_string(jumpRow) + "," + std::to_string(jumpCol) + ").";
+            step.reason = StepRejection::CONTINUATION;
+            return step;
+        }
+    }
+    else {
+        auto requiredJumpsInfo = board.getRequiredJumps(playerColor); // ,   
+        if (!requiredJumpsInfo.empty()) { // ---      .  ---
+            if (!isAttemptedJump) {
+                step.error = "Invalid move: A jump is required.";
+                step.reason = StepRejection::JUMP_REQUIRED;
+                return step;
+            }
+            if (!isPositionInList(fromRow, fromCol, requiredJumpsInfo)) {
+                step.error = "Invalid move: You must jump with a piece from specific positions. Required from: ";
+                for (const auto& pos : requiredJumpsInfo) {
+                    step.error += "(" + std::to_string(pos.first) + "," + std::to_string(pos.second) + ") ";
+                }
+                step.reason = StepRejection::WRONG_JUMPER;
+                return step;
             }
-            else {
-                std::cout << "Invalid continuation jump. You must make a valid jump from (" << fromRow << "," << fromCol << ")." << std::endl;
-                // isValidAction  false
-                // currentPieceRow/Col  ,  while   
+            if (!board.isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor)) {
+                step.error = "Invalid jump destination or path. Please try again.";
+                step.reason = StepRejection::BAD_JUMP;
+                return step;
             }
         }
-        else if (mustJumpGenerally) { // ---      .  ---
-            if (!isAttemptedJump) {
-                std::cout << "Invalid move: A jump is required." << std::endl;
+        else if (!board.isValidMove(fromRow, fromCol, toRow, toCol, playerColor)) { // ---   ---
+            //       
+            if (!board.isInsideBoard(fromRow, fromCol) || !board.isInsideBoard(toRow, toCol)) {
+                step.error = "Invalid move: Coordinates out of bounds.";
+                step.reason = StepRejection::OUT_OF_BOUNDS;
             }
-            else if (!isPositionInList(fromRow, fromCol, requiredJumpsInfo)) {
-                std::cout << "Invalid move: You must jump with a piece from specific positions. Required from: ";
-                for (const auto& pos : requiredJumpsInfo) std::cout << "(" << pos.first << "," << pos.second << ") ";
-                std::cout << std::endl;
+            else if (board.getPieceColor(fromRow, fromCol) != playerColor) {
+                step.error = "Invalid move: No piece of your color at (" + std::to_string(fromRow) + "," + std::to_string(fromCol) + ").";
+                step.reason = StepRejection::NOT_OWN_PIECE;
             }
-            else if (!board.isJumpPossible(fromRow, fromCol, toRow, toCol, playerColor)) {
-                std::cout << "Invalid jump destination or path. Please try again." << std::endl;
+            else if (board.getPiece(toRow, toCol) != nullptr) {
+                step.error = "Invalid move: Destination square (" + std::to_string(toRow) + "," + std::to_string(toCol) + ") is occupied.";
+                step.reason = StepRejection::OCCUPIED;
             }
-            else {
-                isValidAction = true; //      
+            else { //   (  ,      ..)
+                step.error = "Invalid move logic. Please check rules.";
+                step.reason = StepRejection::ILLEGAL;
             }
-            //       , isValidAction  false
+            return step;
         }
-        else { // ---       ---
-            if (board.isValidMove(fromRow, fromCol, toRow, toCol, playerColor)) {
-                // isValidMove  : ,  , ,   ( )
-                isValidAction = true;
-            }
-            else {
-                //       
-                if (!board.isInsideBoard(fromRow, fromCol) || !board.isInsideBoard(toRow, toCol))
-                    std::cout << "Invalid move: Coordinates out of bounds." << std::endl;
-                else if (board.getPieceColor(fromRow, fromCol) != playerColor)
-                    std::cout << "Invalid move: No piece of your color at (" << fromRow << "," << fromCol << ")." << std::endl;
-                else if (board.getPiece(toRow, toCol) != nullptr)
-                    std::cout << "Invalid move: Destination square (" << toRow << "," << toCol << ") is occupied." << std::endl;
-                else //   (  ,      ..)
-                    std::cout << "Invalid move logic. Please check rules." << std::endl;
-                // isValidAction  false
+    }
+
+    // 2.  
+    if (!isContinuationJump) {
+        turnSquares.clear();
+        turnSquares.push_back(Position::square(fromRow, fromCol));
+    }
+    turnSquares.push_back(Position::square(toRow, toCol));
+    lastFromRow = fromRow;
+    lastFromCol = fromCol;
+    lastToRow = toRow;
+    lastToCol = toCol;
+    Piece* movingPiece = board.getPiece(fromRow, fromCol); //    
+    board.setPiece(toRow, toCol, movingPiece);           //     
+    board.clearPiece(fromRow, fromCol);                  //    ( nullptr)
+
+    if (isAttemptedJump) { // ---    ---
+        int rowDir = (toRow - fromRow > 0) ? 1 : -1;
+        int colDir = (toCol - fromCol > 0) ? 1 : -1;
+        for (int i = 1; i < std::abs(toRow - fromRow); ++i) {
+            int currentRow = fromRow + i * rowDir;
+            int currentCol = fromCol + i * colDir;
+            //     
+            if (board.getPiece(currentRow, currentCol) != nullptr && board.getPieceColor(currentRow, currentCol) != playerColor) {
+                board.removePiece(currentRow, currentCol); //   Piece
+                step.captured = true;
+                step.capturedRow = currentRow;
+                step.capturedCol = currentCol;
+                break;
             }
         }
+    }
 
-        // 3.  ,   
-        if (isValidAction) {
-            Piece* movingPiece = board.getPiece(fromRow, fromCol); //    
-            board.setPiece(toRow, toCol, movingPiece);           //     
-            board.clearPiece(fromRow, fromCol);                  //    ( nullptr)
-            bool piecePromoted = false;
-
-            if (isAttemptedJump) { // ---    ---
-                //   
-                int rowDir = (toRow - fromRow > 0) ? 1 : -1;
-                int colDir = (toCol - fromCol > 0) ? 1 : -1;
-                int jumpedRow = -1, jumpedCol = -1;
-                for (int i = 1; i < std::abs(toRow - fromRow); ++i) {
-                    int currentRow = fromRow + i * rowDir;
-                    int currentCol = fromCol + i * colDir;
-                    //     
-                    if (board.getPiece(currentRow, currentCol) != nullptr && board.getPieceColor(currentRow, currentCol) != playerColor) {
-                        jumpedRow = currentRow;
-                        jumpedCol = currentCol;
-                        break;
-                    }
-                }
-                if (jumpedRow != -1) {
-                    board.removePiece(jumpedRow, jumpedCol); //   Piece
-                    // std::cout << "Piece captured at (" << jumpedRow << "," << jumpedCol << ")" << std::endl; // Debug message
-                }
+    //     
+    if (!movingPiece->isKing() && ((playerColor == PieceColor::WHITE && toRow == board.getBoardSize() - 1) || (playerColor == PieceColor::BLACK && toRow == 0))) {
+        movingPiece->makeKing();
+        step.promoted = true;
+    }
 
-                //     
-                if (!movingPiece->isKing() && ((playerColor == PieceColor::WHITE && toRow == board.getBoardSize() - 1) || (playerColor == PieceColor::BLACK && toRow == 0))) {
-                    movingPiece->makeKing();
-                    piecePromoted = true;
-                    std::cout << "Piece promoted to King!" << std::endl;
-                }
+    //   /   (  ).
+    //      -  ,    .
+    if (step.captured && !step.promoted && board.canJumpFrom(toRow, toCol, playerColor)) {
+        jumpRow = toRow; //    . 
+        jumpCol = toCol;
+        step.result = MoveResult::JUMP_CONTINUES;
+        return step;
+    }
 
-                //   /  
-                if (!piecePromoted && board.canJumpFrom(toRow, toCol, playerColor)) {
-                    currentPieceRow = toRow; //    . 
-                    currentPieceCol = toCol;
-                    std::cout << "Another jump possible/required from (" << toRow << "," << toCol << ")." << std::endl;
-                    printBoard(); //     
-                    // turnFinished  false,   while 
-                }
-                else {
-                    turnFinished = true; //  ,  
-                }
-            }
-            else { // ---     ---
-                //     
-                if (!movingPiece->isKing() && ((playerColor == PieceColor::WHITE && toRow == board.getBoardSize() - 1) || (playerColor == PieceColor::BLACK && toRow == 0))) {
-                    movingPiece->makeKing();
-                    // piecePromoted = true; //   
-                    std::cout << "Piece promoted to King!" << std::endl;
-                }
-                turnFinished = true; //     
-            }
-        }
-        // else { //  isValidAction == false
-        //     . turnFinished  false.
-        //    while  ,      .
-        // }
+    //  :    ,    
+    jumpRow = -1;
+    jumpCol = -1;
+    switchPlayer();
+    checkGameEnd();
+    ++ply;
+    publishSnapshot(step.captured); //    - ,  
+    CHETA_PROFILE_MOVE();
+    step.result = MoveResult::TURN_FINISHED;
+    return step;
+}
 
-    } //  while (!turnFinished)
+std::optional<std::pair<int, int>> Game::getJumpingPiece() const
+{
+    if (jumpRow == -1) {
+        return std::nullopt;
+    }
+    return std::make_pair(jumpRow, jumpCol);
+}
+
+std::optional<std::pair<std::pair<int, int>, std::pair<int, int>>> Game::getLastStep() const
+{
+    if (lastFromRow == -1) {
+        return std::nullopt;
+    }
+    return std::make_pair(std::make_pair(lastFromRow, lastFromCol), std::make_pair(lastToRow, lastToCol));
+}
 
-    //  true, ..      /
-    return true;
+void Game::publishSnapshot(bool lastCapture)
+{
+    GameSnapshot snapshot;
+    snapshot.position = Notation::pack(Position::fromBoard(board, getCurrentPlayerColor()));
+    snapshot.state = gameState;
+    snapshot.ply = ply;
+    if (!turnSquares.empty()) {
+        snapshot.lastFrom = static_cast<int8_t>(turnSquares.front());
+        snapshot.lastTo = static_cast<int8_t>(turnSquares.back());
+        snapshot.lastCapture = lastCapture;
+    }
+    snapshots->publish(snapshot);
 }
 
 bool Game::checkGameEnd()
 {
+    CHETA_PROFILE_SCOPE(CHECK_GAME_END);
     int whiteCount = 0;
     int blackCount = 0;
 
@@ -364,6 +451,45 @@ void Game::reset()
     board.initialize();
     currentPlayerIndex = 0;
     gameState = GameState::PLAYING;
+    jumpRow = -1;
+    jumpCol = -1;
+    lastFromRow = lastFromCol = lastToRow = lastToCol = -1;
+    turnSquares.clear();
+    ply = 0;
+    message.clear();
+    if (renderer) {
+        renderer->invalidate();
+    }
+    publishSnapshot(false);
+}
+
+void Game::restore(const Position& position, uint32_t restoredPly, const std::vector<int>& lastTurn, bool lastCapture)
+{
+    position.toBoard(board);
+    currentPlayerIndex = players[0]->getColor() == position.sideToMove ? 0 : 1;
+    gameState = GameState::PLAYING;
+    jumpRow = -1;
+    jumpCol = -1;
+    turnSquares = lastTurn;
+    if (lastTurn.size() >= 2) {
+        //   -     
+        int from = lastTurn[lastTurn.size() - 2];
+        int to = lastTurn.back();
+        lastFromRow = Position::rowOf(from);
+        lastFromCol = Position::colOf(from);
+        lastToRow = Position::rowOf(to);
+        lastToCol = Position::colOf(to);
+    }
+    else {
+        lastFromRow = lastFromCol = lastToRow = lastToCol = -1;
+    }
+    ply = restoredPly;
+    message.clear();
+    if (renderer) {
+        renderer->invalidate();
+    }
+    checkGameEnd();
+    publishSnapshot(lastCapture);
 }
 
 GameState Game::getGameState() const
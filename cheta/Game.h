@@ -4,11 +4,30 @@
 #include "Board.h"
 #include "Player.h"
 #include "Enums.h"
+#include "Snapshot.h"
+#include "EventLog.h"
 #include <vector>
+#include <string>
+#include <optional>
+#include <memory>
+
+class TerminalRenderer;
+struct BoardHighlights;
+
+//   :  ,   ,   .
+struct StepResult {
+	MoveResult result = MoveResult::INVALID;
+	std::string error;            //   (  INVALID)
+	StepRejection reason = StepRejection::NONE;
+	bool captured = false;
+	int capturedRow = -1, capturedCol = -1;
+	bool promoted = false;
+};
 
 class Game {
 public:
-	Game(Player* player1, Player* player2, bool whiteStarts = true);
+	// snapshots -    (, ,   );   
+	Game(Player* player1, Player* player2, bool whiteStarts = true, std::shared_ptr<SnapshotSlot> snapshots = nullptr);
 	~Game();
 
 	void start();          //  
@@ -17,19 +36,54 @@ public:
 	GameState getGameState() const;
 	PieceColor getCurrentPlayerColor() const;
 
+	//       /.    
+	//      ,   .
+	StepResult applyStep(int fromRow, int fromCol, int toRow, int toCol);
+	std::optional<std::pair<int, int>> getJumpingPiece() const; // ,   
+	//    (, ),    
+	std::optional<std::pair<std::pair<int, int>, std::pair<int, int>>> getLastStep() const;
+
 	const Board& getBoard() const { return board; } // .
+	//     .    getBoard,    
+	//    :     ,   .
+	std::shared_ptr<const SnapshotSlot> getSnapshots() const { return snapshots; }
+	//  (0..31,   Position)  :    . 
+	// TURN_FINISHED -   ,    (  ).
+	const std::vector<int>& getLastTurn() const { return turnSquares; }
+	//       ply  (    
+	//  ): lastTurn -   ,   getLastTurn.   
+	//   .
+	void restore(const Position& position, uint32_t restoredPly, const std::vector<int>& lastTurn, bool lastCapture);
+	//   (, , , , )    .
+	//   ,    ; nullptr -   .
+	void setEventLog(std::shared_ptr<EventRing> ring, uint32_t gameId);
 
 private:
+	friend class GameBench; //  cheta_bench  checkGameEnd 
+
 	Board board;
 	std::vector<Player*> players; // ,   ,    
 	int currentPlayerIndex;
 	GameState gameState;
 	bool whiteStarts;
+	int jumpRow, jumpCol; //      (-1,   )
+	int lastFromRow, lastFromCol, lastToRow, lastToCol; //   (-1,    )
+	std::vector<int> turnSquares; //    (0..31):     
+	uint32_t ply;                 //  
+	std::shared_ptr<SnapshotSlot> snapshots;
+	std::shared_ptr<EventRing> events;
+	uint32_t eventGameId;
+	std::unique_ptr<TerminalRenderer> renderer; //    :     
+	std::string message; //    ( ,   ..)
 
 	void switchPlayer();
 	bool makePlayerMove();
 	bool checkGameEnd();
-	void printBoard() const; //      
+	StepResult performStep(int fromRow, int fromCol, int toRow, int toCol); // applyStep  
+	void emitStepEvents(const StepResult& step, int fromRow, int fromCol, int toRow, int toCol, uint32_t turn);
+	void publishSnapshot(bool lastCapture); //    
+	void redraw(const std::string& status); //   (  )
+	BoardHighlights getHighlights() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "HubProtocol.h"
+#include "Notation.h"
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+//    key=value, key="value with spaces"   
+struct Arguments {
+    std::vector<std::pair<std::string, std::string>> items;
+
+    explicit Arguments(const std::string& text) {
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && text[i] == ' ') ++i;
+            if (i >= text.size()) break;
+            size_t start = i;
+            while (i < text.size() && text[i] != ' ' && text[i] != '=') ++i;
+            std::string key = text.substr(start, i - start);
+            std::string value;
+            if (i < text.size() && text[i] == '=') {
+                ++i;
+                if (i < text.size() && text[i] == '"') {
+                    size_t end = text.find('"', i + 1);
+                    if (end == std::string::npos) end = text.size();
+                    value = text.substr(i + 1, end - i - 1);
+                    i = end + 1;
+                }
+                else {
+                    start = i;
+                    while (i < text.size() && text[i] != ' ') ++i;
+                    value = text.substr(start, i - start);
+                }
+            }
+            items.emplace_back(key, value);
+        }
+    }
+
+    bool has(const std::string& key) const {
+        for (const auto& item : items) {
+            if (item.first == key) return true;
+        }
+        return false;
+    }
+
+    std::string get(const std::string& key) const {
+        for (const auto& item : items) {
+            if (item.first == key) return item.second;
+        }
+        return "";
+    }
+};
+
+} // namespace
+
+HubEngine::HubEngine(std::istream& input, std::FILE* output) :
+    input(input), output(output), lastFlush(std::chrono::steady_clock::now()),
+    position(Position::initial()), infinite(false) {}
+
+HubEngine::~HubEngine() {
+    stopSearch();
+}
+
+void HubEngine::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    outputBuffer += line;
+    outputBuffer += '\n';
+}
+
+void HubEngine::flush() {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    if (!outputBuffer.empty()) {
+        std::fwrite(outputBuffer.data(), 1, outputBuffer.size(), output);
+        std::fflush(output);
+        outputBuffer.clear();
+    }
+    lastFlush = std::chrono::steady_clock::now();
+}
+
+void HubEngine::flushIfDue() {
+    bool due;
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        due = std::chrono::steady_clock::now() - lastFlush >= std::chrono::milliseconds(flushIntervalMs);
+    }
+    if (due) flush();
+}
+
+int HubEngine::run() {
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        bool keepGoing = handle(line);
+        flush();
+        if (!keepGoing) break;
+    }
+    //  :   (done        )
+    stopSearch();
+    flush();
+    return 0;
+}
+
+bool HubEngine::handle(const std::string& line) {
+    size_t space = line.find(' ');
+    std::string command = line.substr(0, space);
+    Arguments args(space == std::string::npos ? "" : line.substr(space + 1));
+
+    if (command.empty()) {
+        return true;
+    }
+    if (command == "hub") {
+        send("id name=cheta version=1.0");
+        send("wait");
+    }
+    else if (command == "init") {
+        send("ready");
+    }
+    else if (command == "ping") {
+        send("pong");
+    }
+    else if (command == "new-game") {
+        stopSearch();
+        search.clear();
+    }
+    else if (command == "pos") {
+        stopSearch();
+        Position next = Position::initial();
+        if (args.has("pos") && !Notation::parse(args.get("pos"), next)) {
+            send("error message=\"bad position\"");
+            return true;
+        }
+        Arguments moves(args.get("moves"));
+        for (const auto& item : moves.items) {
+            Move move;
+            if (!MoveGen::parse(next, item.first, move)) {
+                send("error message=\"illegal move " + item.first + "\"");
+                return true;
+            }
+            next = MoveGen::apply(next, move);
+        }
+        position = next;
+    }
+    else if (command == "level") {
+        limits = SearchLimits();
+        infinite = args.has("infinite");
+        if (args.has("depth")) limits.depth = std::atoi(args.get("depth").c_str());
+        if (args.has("move-time")) limits.moveTimeMs = static_cast<int>(std::atof(args.get("move-time").c_str()) * 1000);
+    }
+    else if (command == "go") {
+        stopSearch();
+        startSearch(args.has("analyze") || infinite);
+    }
+    else if (command == "stop") {
+        stopSearch();
+    }
+    else if (command == "quit") {
+        return false;
+    }
+    else {
+        send("error message=\"unknown command " + command + "\"");
+    }
+    return true;
+}
+
+void HubEngine::startSearch(bool analyze) {
+    SearchLimits searchLimits = limits;
+    if (analyze) {
+        searchLimits = SearchLimits(); //     stop
+    }
+    else if (searchLimits.moveTimeMs == 0 && searchLimits.depth == SearchLimits().depth) {
+        searchLimits.moveTimeMs = defaultMoveTimeMs; // level      
+    }
+    Position root = position;
+    search.resetStop();
+    thinker = std::thread([this, root, searchLimits]() {
+        Move best;
+        bool found = search.think(root, searchLimits, [this](const SearchInfo& info) {
+            std::string pv;
+            for (const Move& move : info.pv) {
+                if (!pv.empty()) pv += ' ';
+                pv += MoveGen::toString(move);
+            }
+            char numbers[160];
+            std::snprintf(numbers, sizeof(numbers), "info depth=%d score=%d nodes=%llu nps=%llu time=%.3f",
+                info.depth, info.score, static_cast<unsigned long long>(info.nodes),
+                static_cast<unsigned long long>(info.nps), info.timeMs / 1000.0);
+            send(std::string(numbers) + " pv=\"" + pv + "\"");
+            flushIfDue();
+        }, best);
+        send(found ? "done move=" + MoveGen::toString(best) : "done");
+        flush();
+    });
+}
+
+void HubEngine::stopSearch() {
+    if (thinker.joinable()) {
+        search.stop();
+        thinker.join();
+    }
+}
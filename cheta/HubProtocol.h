@@ -0,0 +1,59 @@
+#ifndef HUB_PROTOCOL_H
+#define HUB_PROTOCOL_H
+
+#include "Search.h"
+#include <chrono>
+#include <cstdio>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+//  :     Hub/DXP  stdin/stdout  GUI   .
+//
+//   hub                             -> id name=... version=..., wait
+//   init                            -> ready
+//   new-game                             
+//   pos [pos=<>] [moves="9-13 22-18 ..."]    -  Hub  FEN (. Notation.h)
+//   level [depth=N] [move-time=] [infinite]    depth  move-time   defaultMoveTimeMs
+//   go think | go analyze           -> info depth= score= nodes= nps= time= pv="...", ..., done move=...
+//   stop                                 (done  )
+//   ping                            -> pong
+//   quit                                   
+//
+//          ,     -  
+//   flushIntervalMs,   info      .
+class HubEngine {
+public:
+    static const int flushIntervalMs = 50;
+    static const int defaultMoveTimeMs = 1000;
+
+    HubEngine(std::istream& input, std::FILE* output);
+    ~HubEngine();
+
+    int run(); //    quit   
+
+private:
+    std::istream& input;
+    std::FILE* output;
+
+    std::mutex outputMutex;
+    std::string outputBuffer;
+    std::chrono::steady_clock::time_point lastFlush;
+
+    Position position;
+    SearchLimits limits;
+    bool infinite;
+    Search search;
+    std::thread thinker;
+
+    bool handle(const std::string& line); // false - 
+    void startSearch(bool analyze);
+    void stopSearch();
+
+    void send(const std::string& line);
+    void flush();
+    void flushIfDue();
+};
+
+#endif
@@ -0,0 +1,592 @@
+#include "Journal.h"
+#include "MoveGen.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+int openForAppend(const std::string& path) {
+    return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+int openForRewrite(const std::string& path) {
+    return ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+long writeSome(int fd, const char* data, size_t size) { return ::_write(fd, data, static_cast<unsigned>(size)); }
+bool syncFile(int fd) { return ::_commit(fd) == 0; }
+bool syncDirectoryOf(const std::string&) { return true; } //   NTFS   
+void closeFile(int fd) { ::_close(fd); }
+#else
+int openForAppend(const std::string& path) {
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+}
+int openForRewrite(const std::string& path) {
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+}
+long writeSome(int fd, const char* data, size_t size) { return static_cast<long>(::write(fd, data, size)); }
+bool syncFile(int fd) { return ::fdatasync(fd) == 0; }
+void closeFile(int fd) { ::close(fd); }
+
+//        ,     
+bool syncDirectoryOf(const std::string& path) {
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int dir = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir == -1) return false;
+    bool ok = ::fsync(dir) == 0;
+    ::close(dir);
+    return ok;
+}
+#endif
+
+bool writeAll(int fd, const char* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        long result = writeSome(fd, data + written, size - written);
+        if (result > 0) {
+            written += static_cast<size_t>(result);
+        }
+        else if (result < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void putUint32(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint32_t getUint32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+        (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+//  SNAPSHOT  id  :  , PackedPosition,  
+const size_t snapshotSize = 4 + sizeof(PackedPosition) + 1;
+
+size_t encode(const JournalRecord& record, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(record.type);
+    out[1] = record.squareCount;
+    putUint32(out + 2, record.gameId);
+    size_t size = 6;
+    if (record.type == JournalRecordType::SNAPSHOT) {
+        putUint32(out + size, record.ply);
+        std::memcpy(out + size + 4, record.position.bytes, sizeof(PackedPosition));
+        out[size + snapshotSize - 1] = record.lastCapture ? 1 : 0;
+        size += snapshotSize;
+    }
+    std::memcpy(out + size, record.squares, record.squareCount);
+    size += record.squareCount;
+    putUint32(out + size, checksum(out, size));
+    return size + 4;
+}
+
+//     data. 0 -       .
+size_t decode(const uint8_t* data, size_t available, JournalRecord& record) {
+    if (available < 10) return 0;
+    uint8_t type = data[0];
+    uint8_t count = data[1];
+    if (type < 1 || type > 4 || count > sizeof(record.squares)) return 0;
+    size_t header = type == static_cast<uint8_t>(JournalRecordType::SNAPSHOT) ? 6 + snapshotSize : 6;
+    size_t size = header + count;
+    if (available < size + 4 || getUint32(data + size) != checksum(data, size)) return 0;
+    record.type = static_cast<JournalRecordType>(type);
+    record.squareCount = count;
+    record.gameId = getUint32(data + 2);
+    if (header > 6) {
+        record.ply = getUint32(data + 6);
+        std::memcpy(record.position.bytes, data + 10, sizeof(PackedPosition));
+        record.lastCapture = data[6 + snapshotSize - 1] != 0;
+    }
+    std::memcpy(record.squares, data + header, count);
+    return size + 4;
+}
+
+//          :   Game 
+// ,    -  .
+bool applyTurn(JournalGameState& game, const JournalRecord& record) {
+    Move move;
+    if (!MoveGen::fromSquares(game.position, record.squares, record.squareCount, move)) {
+        return false;
+    }
+    game.position = MoveGen::apply(game.position, move);
+    game.lastTurn.assign(record.squares, record.squares + record.squareCount);
+    game.lastCapture = move.isCapture();
+    ++game.ply;
+    return true;
+}
+
+Game* newRemoteGame() {
+    return new Game(new RemotePlayer("White", PieceColor::WHITE), new RemotePlayer("Black", PieceColor::BLACK));
+}
+
+} // namespace
+
+bool applyJournalRecord(std::unordered_map<uint32_t, JournalGameState>& games, const JournalRecord& record)
+{
+    switch (record.type) {
+    case JournalRecordType::NEW:
+        games[record.gameId] = JournalGameState();
+        break;
+    case JournalRecordType::CLOSE:
+        games.erase(record.gameId);
+        break;
+    case JournalRecordType::SNAPSHOT: {
+        JournalGameState& game = games[record.gameId];
+        game.position = Notation::unpack(record.position);
+        game.ply = record.ply;
+        game.lastTurn.assign(record.squares, record.squares + record.squareCount);
+        game.lastCapture = record.lastCapture;
+        break;
+    }
+    case JournalRecordType::TURN: {
+        auto it = games.find(record.gameId);
+        return it != games.end() && applyTurn(it->second, record);
+    }
+    }
+    return true;
+}
+
+MoveJournal::MoveJournal(const std::string& path, std::chrono::microseconds commitDelay, uint64_t compactBytes) :
+    path(path), commitDelay(commitDelay), compactBytes(compactBytes), fd(-1), fileBytes(0), compactedBytes(0),
+    appended(0), durable(0), stopping(false), failed(false)
+{
+}
+
+MoveJournal::~MoveJournal()
+{
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        pendingReady.notify_one();
+        writer.join();
+    }
+    if (fd != -1) {
+        closeFile(fd);
+    }
+}
+
+bool MoveJournal::open()
+{
+    if (compactBytes > 0) {
+        openGames.clear();
+        if (!replay(path, [this](const JournalRecord& record) { applyJournalRecord(openGames, record); })) {
+            return false;
+        }
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(path, error);
+        fileBytes = error ? 0 : size;
+        if (fileBytes > compactBytes && !compact()) {
+            return false;
+        }
+    }
+    if (fd == -1) {
+        fd = openForAppend(path);
+    }
+    if (fd == -1) {
+        std::cerr << "Cannot open journal " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    writer = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+uint64_t MoveJournal::append(const JournalRecord& record)
+{
+    uint8_t encoded[maxRecordSize];
+    size_t size = encode(record, encoded);
+    bool wasEmpty;
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) {
+            return appended + 1; //      
+        }
+        wasEmpty = pending.empty();
+        pending.append(reinterpret_cast<const char*>(encoded), size);
+        ticket = ++appended;
+    }
+    if (wasEmpty) {
+        pendingReady.notify_one();
+    }
+    return ticket;
+}
+
+uint64_t MoveJournal::logNew(uint32_t gameId)
+{
+    JournalRecord record;
+    record.type = JournalRecordType::NEW;
+    record.gameId = gameId;
+    return append(record);
+}
+
+uint64_t MoveJournal::logTurn(uint32_t gameId, const std::vector<int>& squares)
+{
+    JournalRecord record;
+    //     - 12 , 13 ;  -  
+    assert(squares.size() <= sizeof(record.squares));
+    if (squares.size() > sizeof(record.squares)) {
+        return 0;
+    }
+    record.type = JournalRecordType::TURN;
+    record.gameId = gameId;
+    record.squareCount = static_cast<uint8_t>(squares.size());
+    for (int i = 0; i < record.squareCount; ++i) {
+        record.squares[i] = static_cast<uint8_t>(squares[i]);
+    }
+    return append(record);
+}
+
+uint64_t MoveJournal::logClose(uint32_t gameId)
+{
+    JournalRecord record;
+    record.type = JournalRecordType::CLOSE;
+    record.gameId = gameId;
+    return append(record);
+}
+
+bool MoveJournal::waitDurable(uint64_t ticket)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    durableReady.wait(lock, [this, ticket]() { return durable >= ticket || failed; });
+    return durable >= ticket;
+}
+
+JournalStats MoveJournal::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return totals;
+}
+
+void MoveJournal::writerLoop()
+{
+    std::string batch;
+    while (true) {
+        uint64_t batchEnd;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            pendingReady.wait(lock, [this]() { return !pending.empty() || stopping; });
+            if (pending.empty()) {
+                return; // ,  
+            }
+            if (commitDelay.count() > 0 && !stopping) {
+                //          
+                pendingReady.wait_for(lock, commitDelay, [this]() { return stopping; });
+            }
+            batch.swap(pending);
+            batchEnd = appended;
+        }
+
+        bool ok = writeAll(fd, batch.data(), batch.size()) && syncFile(fd);
+        if (!ok) {
+            std::cerr << "Journal write failed: " << std::strerror(errno) << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ok) {
+                totals.records += batchEnd - durable;
+                totals.bytes += batch.size();
+                ++totals.syncs;
+                durable = batchEnd;
+            }
+            else {
+                failed = true;
+                pending.clear(); //     , append   
+            }
+        }
+        durableReady.notify_all();
+        if (!ok) {
+            return;
+        }
+        if (compactBytes > 0) {
+            track(batch);
+            if (fileBytes > compactBytes && fileBytes > 2 * compactedBytes && !compact()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+                pending.clear();
+                durableReady.notify_all();
+                return;
+            }
+        }
+        batch.clear();
+    }
+}
+
+void MoveJournal::track(const std::string& batch)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(batch.data());
+    JournalRecord record;
+    for (size_t offset = 0; offset < batch.size();) {
+        size_t size = decode(data + offset, batch.size() - offset, record);
+        if (size == 0) break;
+        applyJournalRecord(openGames, record);
+        offset += size;
+    }
+    fileBytes += batch.size();
+}
+
+bool MoveJournal::compact()
+{
+    std::string data;
+    data.reserve(openGames.size() * 32);
+    uint8_t encoded[maxRecordSize];
+    for (const auto& entry : openGames) {
+        JournalRecord record;
+        record.type = JournalRecordType::SNAPSHOT;
+        record.gameId = entry.first;
+        record.ply = entry.second.ply;
+        record.position = Notation::pack(entry.second.position);
+        record.lastCapture = entry.second.lastCapture;
+        record.squareCount = static_cast<uint8_t>(entry.second.lastTurn.size());
+        for (int i = 0; i < record.squareCount; ++i) {
+            record.squares[i] = static_cast<uint8_t>(entry.second.lastTurn[i]);
+        }
+        data.append(reinterpret_cast<const char*>(encoded), encode(record, encoded));
+    }
+
+    //          :  
+    //         ,  
+    std::string temporary = path + ".tmp";
+    std::error_code error;
+    int out = openForRewrite(temporary);
+    bool written = out != -1 && writeAll(out, data.data(), data.size()) && syncFile(out);
+    if (out != -1) {
+        closeFile(out);
+    }
+    if (written) {
+        if (fd != -1) {
+            closeFile(fd);
+            fd = -1;
+        }
+        std::filesystem::rename(temporary, path, error);
+        written = !error && syncDirectoryOf(path);
+    }
+    if (!written) {
+        //      ;  ,   
+        std::cerr << "Cannot compact journal " << path << ": "
+            << (error ? error.message() : std::string(std::strerror(errno))) << std::endl;
+        std::filesystem::remove(temporary, error);
+    }
+    else {
+        fileBytes = data.size();
+        std::lock_guard<std::mutex> lock(mutex);
+        ++totals.compactions;
+    }
+    compactedBytes = fileBytes;
+    if (fd == -1) {
+        fd = openForAppend(path);
+        if (fd == -1) {
+            std::cerr << "Cannot reopen journal " << path << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MoveJournal::replay(const std::string& path, const std::function<void(const JournalRecord&)>& visitor)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return !std::filesystem::exists(path);
+    }
+    std::vector<uint8_t> buffer(1 << 20);
+    size_t filled = 0;
+    uint64_t validBytes = 0;
+    bool torn = false;
+    JournalRecord record;
+    while (!torn) {
+        size_t got = std::fread(buffer.data() + filled, 1, buffer.size() - filled, file);
+        filled += got;
+        size_t offset = 0;
+        while (true) {
+            size_t size = decode(buffer.data() + offset, filled - offset, record);
+            if (size == 0) break;
+            visitor(record);
+            offset += size;
+            validBytes += size;
+        }
+        //  :      
+        if (got == 0 || (offset == 0 && filled - offset >= static_cast<size_t>(maxRecordSize))) {
+            torn = filled - offset > 0;
+            break;
+        }
+        std::memmove(buffer.data(), buffer.data() + offset, filled - offset);
+        filled -= offset;
+    }
+    bool readError = std::ferror(file) != 0;
+    std::fclose(file);
+    if (readError) {
+        std::cerr << "Cannot read journal " << path << std::endl;
+        return false;
+    }
+    if (torn) {
+        std::error_code error;
+        std::filesystem::resize_file(path, validBytes, error);
+        std::cerr << "Journal " << path << ": dropped damaged tail after " << validBytes << " bytes" << std::endl;
+    }
+    return true;
+}
+
+bool recoverGames(const std::string& path, std::unordered_map<uint32_t, std::unique_ptr<Game>>& games, JournalRecovery& report)
+{
+    auto started = std::chrono::steady_clock::now();
+    //       , Game     
+    std::unordered_map<uint32_t, JournalGameState> states;
+    bool ok = MoveJournal::replay(path, [&states, &report](const JournalRecord& record) {
+        ++report.records;
+        if (!applyJournalRecord(states, record)) {
+            ++report.rejected;
+        }
+        else if (record.type == JournalRecordType::TURN) {
+            ++report.turns;
+        }
+    });
+    for (auto& entry : states) {
+        std::unique_ptr<Game> game(newRemoteGame());
+        game->restore(entry.second.position, entry.second.ply, entry.second.lastTurn, entry.second.lastCapture);
+        games[entry.first] = std::move(game);
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return ok;
+}
+
+namespace {
+
+//    :  ,       
+void runBenchThread(MoveJournal& journal, int thread, int games, int maxPlies,
+    std::unordered_map<uint32_t, std::unique_ptr<Game>>& live, uint64_t& turns) {
+    std::mt19937 rng(static_cast<unsigned>(thread + 1));
+    std::vector<uint32_t> playing;
+    uint64_t ticket = 0;
+    for (int i = 0; i < games; ++i) {
+        uint32_t id = static_cast<uint32_t>(thread * games + i + 1);
+        live[id].reset(newRemoteGame());
+        playing.push_back(id);
+        ticket = journal.logNew(id);
+    }
+    MoveList moves;
+    while (!playing.empty()) {
+        for (size_t i = 0; i < playing.size();) {
+            uint32_t id = playing[i];
+            Game& game = *live[id];
+            GameSnapshot snapshot;
+            game.getSnapshots()->read(snapshot);
+            MoveGen::generate(Position::fromBoard(game.getBoard(), game.getCurrentPlayerColor()), moves);
+            if (game.isGameOver() || static_cast<int>(snapshot.ply) >= maxPlies || moves.count == 0) {
+                //     ,    
+                if (id % 3 == 0) {
+                    ticket = journal.logClose(id);
+                    live.erase(id);
+                }
+                playing[i] = playing.back();
+                playing.pop_back();
+                continue;
+            }
+            const Move& move = moves.moves[std::uniform_int_distribution<int>(0, moves.count - 1)(rng)];
+            int from = move.from;
+            for (int step = 0; step < move.pathLength; ++step) {
+                int to = move.path[step];
+                game.applyStep(Position::rowOf(from), Position::colOf(from), Position::rowOf(to), Position::colOf(to));
+                from = to;
+            }
+            ticket = journal.logTurn(id, game.getLastTurn());
+            ++turns;
+            ++i;
+        }
+        journal.waitDurable(ticket); //    :    
+    }
+}
+
+} // namespace
+
+int runJournalBench(const std::string& path, int threads, int games, int maxPlies, int commitDelayUs, uint64_t compactBytes)
+{
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    std::vector<std::unordered_map<uint32_t, std::unique_ptr<Game>>> live(static_cast<size_t>(threads));
+    std::vector<uint64_t> turns(static_cast<size_t>(threads), 0);
+    JournalStats stats;
+    double seconds;
+    {
+        MoveJournal journal(path, std::chrono::microseconds(commitDelayUs), compactBytes);
+        if (!journal.open()) {
+            return 1;
+        }
+        auto started = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back(runBenchThread, std::ref(journal), t, games, maxPlies,
+                std::ref(live[static_cast<size_t>(t)]), std::ref(turns[static_cast<size_t>(t)]));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        stats = journal.stats();
+    }
+    uint64_t totalTurns = 0;
+    for (uint64_t count : turns) {
+        totalTurns += count;
+    }
+    std::cout << "Journal: " << totalTurns << " turns in " << seconds << " s, "
+        << static_cast<uint64_t>(totalTurns / seconds) << " turns/s, "
+        << stats.syncs << " syncs (" << static_cast<uint64_t>(stats.syncs / seconds) << "/s, "
+        << (stats.syncs ? stats.records / stats.syncs : 0) << " records per sync), "
+        << stats.bytes << " bytes, " << stats.compactions << " compactions" << std::endl;
+
+    std::unordered_map<uint32_t, std::unique_ptr<Game>> recovered;
+    JournalRecovery report;
+    if (!recoverGames(path, recovered, report)) {
+        return 1;
+    }
+    uint64_t mismatches = report.rejected;
+    size_t liveGames = 0;
+    for (const auto& games : live) {
+        liveGames += games.size();
+        for (const auto& entry : games) {
+            auto it = recovered.find(entry.first);
+            GameSnapshot expected, actual;
+            entry.second->getSnapshots()->read(expected);
+            if (it == recovered.end() || !it->second->getSnapshots()->read(actual) ||
+                !(expected.position == actual.position) || expected.ply != actual.ply || expected.state != actual.state ||
+                expected.lastFrom != actual.lastFrom || expected.lastTo != actual.lastTo || expected.lastCapture != actual.lastCapture) {
+                ++mismatches;
+            }
+        }
+    }
+    mismatches += recovered.size() != liveGames;
+    std::cout << "Recovery: " << recovered.size() << " games, " << report.turns << " turns from "
+        << report.records << " records in " << report.seconds * 1000 << " ms ("
+        << static_cast<uint64_t>(report.turns / std::max(report.seconds, 1e-9)) << " turns/s), mismatches: "
+        << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
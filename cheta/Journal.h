@@ -0,0 +1,153 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "Game.h"
+#include "Notation.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//   (write-ahead log)      .
+//     ,  . :
+//    (1 ) |   n (1 ) | id  (4 ) | n  |   (4 )
+// : NEW -  , TURN -   (     ,
+//  0..31   Position), CLOSE -  , SNAPSHOT -  : 
+//      (4), PackedPosition (11)    (1).
+//  little-endian,  FNV-1a     .  
+// 10     (SNAPSHOT -  16).
+//
+// :         .  
+//   compactBytes (    ),    
+//    SNAPSHOT  ,      .
+//          ,   
+// .   ,     .
+//
+//  :           .
+//      write    fdatasync   ,
+//        ,   .  
+//    ,    waitDurable (    ).
+enum class JournalRecordType : uint8_t {
+    NEW = 1,
+    TURN = 2,
+    CLOSE = 3,
+    SNAPSHOT = 4
+};
+
+struct JournalRecord {
+    JournalRecordType type = JournalRecordType::NEW;
+    uint32_t gameId = 0;
+    uint8_t squareCount = 0;
+    uint8_t squares[14] = {};
+    //  SNAPSHOT:   ply , squares -  
+    uint32_t ply = 0;
+    PackedPosition position{};
+    bool lastCapture = false;
+};
+
+//    :    
+struct JournalGameState {
+    Position position = Position::initial();
+    uint32_t ply = 0;
+    std::vector<int> lastTurn;
+    bool lastCapture = false;
+};
+
+struct JournalStats {
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    uint64_t syncs = 0;
+    uint64_t compactions = 0;
+};
+
+class MoveJournal {
+public:
+    static const int maxRecordSize = 2 + 4 + 16 + 14 + 4;
+    static const uint64_t defaultCompactBytes = 64ull << 20;
+
+    // commitDelay -        ,  
+    // (0 -  :    ,    fdatasync).
+    // compactBytes -  ,     (0 - )
+    explicit MoveJournal(const std::string& path, std::chrono::microseconds commitDelay = std::chrono::microseconds(0),
+        uint64_t compactBytes = defaultCompactBytes);
+    ~MoveJournal(); //    ,   
+
+    //   (    ),     ,
+    //        . false  
+    bool open();
+
+    //          waitDurable.    .
+    //       :      .
+    uint64_t logNew(uint32_t gameId);
+    // 0 -    ( 13 );     
+    uint64_t logTurn(uint32_t gameId, const std::vector<int>& squares);
+    uint64_t logClose(uint32_t gameId);
+
+    // ,     ticket (   )   . false,   .
+    bool waitDurable(uint64_t ticket);
+
+    JournalStats stats() const;
+
+    //     visitor      .  
+    // (  ) ,        .
+    // false,     .   -  .
+    static bool replay(const std::string& path, const std::function<void(const JournalRecord&)>& visitor);
+
+private:
+    std::string path;
+    std::chrono::microseconds commitDelay;
+    uint64_t compactBytes;
+    int fd;
+
+    //    ( open   ):    
+    std::unordered_map<uint32_t, JournalGameState> openGames;
+    uint64_t fileBytes;        //  
+    uint64_t compactedBytes;   //      
+
+    mutable std::mutex mutex;
+    std::condition_variable pendingReady;  //    (  )
+    std::condition_variable durableReady;  //   (  waitDurable)
+    std::string pending;                   // ,     write
+    uint64_t appended;                     //    
+    uint64_t durable;                      //    
+    bool stopping;
+    bool failed;
+    JournalStats totals;
+    std::thread writer;
+
+    uint64_t append(const JournalRecord& record);
+    void writerLoop();
+    void track(const std::string& batch); //     openGames
+    bool compact();                       // false -     ,  
+};
+
+//     
+struct JournalRecovery {
+    uint64_t records = 0;
+    uint64_t turns = 0;
+    uint64_t rejected = 0;   // ,      
+    double seconds = 0;
+};
+
+//      . false -      
+//   (  ).
+bool applyJournalRecord(std::unordered_map<uint32_t, JournalGameState>& games, const JournalRecord& record);
+
+//     .     
+// (Position, MoveGen::apply)    , Game    
+//     (Game::restore).     RemotePlayer,   .
+bool recoverGames(const std::string& path, std::unordered_map<uint32_t, std::unique_ptr<Game>>& games, JournalRecovery& report);
+
+//   : threads    games  , 
+//    ,         (
+//   ).        .
+// compactBytes -   .  path .    main.
+int runJournalBench(const std::string& path, int threads, int games, int maxPlies, int commitDelayUs, uint64_t compactBytes);
+
+#endif
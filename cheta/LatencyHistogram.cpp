@@ -0,0 +1,78 @@
+#include "LatencyHistogram.h"
+#include <cstdio>
+
+LatencyHistogram::LatencyHistogram() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketOf(uint64_t value) {
+    if (value < 16) {
+        return static_cast<int>(value); //    
+    }
+    int exponent = 4;
+    while ((value >> (exponent + 1)) != 0) {
+        ++exponent;
+    }
+    int sub = static_cast<int>((value >> (exponent - 3)) & 7); // 3   
+    return 16 + (exponent - 4) * 8 + sub;
+}
+
+uint64_t LatencyHistogram::bucketValue(int bucket) {
+    if (bucket < 16) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int exponent = (bucket - 16) / 8 + 4;
+    uint64_t sub = static_cast<uint64_t>((bucket - 16) % 8);
+    return (8 + sub) << (exponent - 3); //   
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    int bucket = bucketOf(nanoseconds);
+    if (bucket >= bucketCount) {
+        bucket = bucketCount - 1;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < bucketCount; ++i) {
+        buckets[i].fetch_add(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total));
+    if (target >= total) {
+        target = total - 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen > target) {
+            return bucketValue(i);
+        }
+    }
+    return bucketValue(bucketCount - 1);
+}
+
+std::string LatencyHistogram::summary() const {
+    char text[128];
+    std::snprintf(text, sizeof(text), "n=%llu p50=%.1fus p99=%.1fus",
+        static_cast<unsigned long long>(count()),
+        percentile(50) / 1000.0, percentile(99) / 1000.0);
+    return text;
+}
@@ -0,0 +1,31 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//        (8   ,
+//     12.5%).  -   ,  ,
+//      .
+class LatencyHistogram {
+public:
+    static const int bucketCount = 16 + 60 * 8;
+
+    LatencyHistogram();
+
+    void record(uint64_t nanoseconds);
+    void merge(const LatencyHistogram& other);
+    uint64_t count() const;
+    uint64_t percentile(double p) const; //   , p  0  100
+
+    std::string summary() const; // "n=... p50=...us p99=...us"
+
+private:
+    std::atomic<uint64_t> buckets[bucketCount];
+
+    static int bucketOf(uint64_t value);
+    static uint64_t bucketValue(int bucket);
+};
+
+#endif
@@ -1,8 +1,188 @@
 #include "Game.h"
 #include "Player.h"
+#include "Server.h"
+#include "Journal.h"
+#include "Archive.h"
+#include "ArchiveStats.h"
+#include "ArchiveCodec.h"
+#include "PositionIndex.h"
+#include "BatchSimulator.h"
+#include "EventLog.h"
+#include "HubProtocol.h"
+#include "Analyzer.h"
+#include "Solver.h"
+#include "VariantMoveGen.h"
+#include <charconv>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
-int main() {
+//      "--name value"  defaultValue,   
+static std::string getOption(const std::vector<std::string>& args, const std::string& name, const std::string& defaultValue) {
+    for (size_t i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == name) {
+            return args[i + 1];
+        }
+    }
+    return defaultValue;
+}
+
+//     . ,       -
+//        1 (     std::stoi)
+template <typename T>
+static T parseNumber(const std::string& text, const std::string& name) {
+    T value{};
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || text[0] == '-' || result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        std::cerr << "Bad value for " << name << ": '" << text << "', expected a non-negative integer" << std::endl;
+        std::exit(1);
+    }
+    return value;
+}
+
+//   "--name N"  defaultValue,   
+template <typename T>
+static T getNumberOption(const std::vector<std::string>& args, const std::string& name, T defaultValue) {
+    for (size_t i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == name) {
+            return parseNumber<T>(args[i + 1], name);
+        }
+    }
+    return defaultValue;
+}
+
+static ServerConfig readServerConfig(const std::vector<std::string>& args) {
+    ServerConfig config;
+    config.unixPath = getOption(args, "--unix", "");
+    config.tcpPort = getNumberOption<int>(args, "--tcp", 7777);
+    config.workers = getNumberOption<int>(args, "--workers", 4);
+    config.journalPath = getOption(args, "--journal", "");
+    config.claimTimeoutSeconds = getNumberOption<int>(args, "--claim-timeout", 300);
+    config.eventsPath = getOption(args, "--events", "");
+    return config;
+}
+
+int main(int argc, char* argv[]) {
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    //    
+    if (!args.empty() && args[0] == "--server") {
+        return runServer(readServerConfig(args));
+    }
+    if (!args.empty() && args[0] == "--server-load") {
+        return runLoadClient(readServerConfig(args),
+            getNumberOption<int>(args, "--connections", 8),
+            getNumberOption<int>(args, "--games", 100),
+            getNumberOption<int>(args, "--plies", 200));
+    }
+
+    if (args.size() >= 2 && args[0] == "--journal-bench") {
+        return runJournalBench(args[1],
+            getNumberOption<int>(args, "--threads", 4),
+            getNumberOption<int>(args, "--games", 1000),
+            getNumberOption<int>(args, "--plies", 100),
+            getNumberOption<int>(args, "--delay", 0),
+            getNumberOption<unsigned long long>(args, "--compact", MoveJournal::defaultCompactBytes));
+    }
+
+    if (args.size() >= 2 && args[0] == "--archive-generate") {
+        return runArchiveGenerate(args[1],
+            getNumberOption<int>(args, "--games", 1000),
+            getNumberOption<int>(args, "--plies", 200),
+            getNumberOption<unsigned long>(args, "--keyframe", ArchiveWriter::defaultKeyframeInterval),
+            getNumberOption<unsigned long>(args, "--seed", 1));
+    }
+    if (args.size() >= 3 && args[0] == "--archive-import") {
+        return runArchiveImport(args[1], args[2],
+            getNumberOption<unsigned long>(args, "--keyframe", ArchiveWriter::defaultKeyframeInterval));
+    }
+    if (args.size() >= 4 && args[0] == "--archive-position") {
+        return runArchivePosition(args[1],
+            parseNumber<unsigned long>(args[2], "game number"), parseNumber<unsigned long>(args[3], "ply"));
+    }
+    if (args.size() >= 2 && args[0] == "--archive-stats") {
+        StatsConfig config;
+        for (size_t i = 1; i < args.size() && args[i].rfind("--", 0) != 0; ++i) {
+            config.paths.push_back(args[i]);
+        }
+        config.threads = getNumberOption<int>(args, "--threads", 0);
+        config.openingPlies = getNumberOption<int>(args, "--opening-plies", 4);
+        config.top = getNumberOption<int>(args, "--top", 10);
+        return runArchiveStats(config);
+    }
+    if (args.size() >= 2 && args[0] == "--archive-seek") {
+        return runArchiveSeekBench(args[1], getNumberOption<int>(args, "--samples", 100000));
+    }
+    if (args.size() >= 3 && args[0] == "--archive-pack") {
+        CodecConfig config;
+        config.threads = getNumberOption<int>(args, "--threads", 0);
+        config.blockGames = getNumberOption<unsigned long>(args, "--block", 4096);
+        return runArchivePack(args[1], args[2], config);
+    }
+    if (args.size() >= 2 && args[0] == "--archive-unpack") {
+        CodecConfig config;
+        config.threads = getNumberOption<int>(args, "--threads", 0);
+        return runArchiveUnpack(args[1], args.size() >= 3 && args[2].rfind("--", 0) != 0 ? args[2] : "", config);
+    }
+
+    if (!args.empty() && args[0] == "--index-bench") {
+        std::string signatures = args.size() >= 2 && args[1].rfind("--", 0) != 0 ? args[1] : "1,0,1,0 0,1,0,1 2,0,2,0 2,1,1,1 3,0,3,0 2,2,2,2 4,0,4,0 6,0,6,0 8,4,8,4";
+        for (char& c : signatures) {
+            if (c == ';') c = ' ';
+        }
+        return runIndexBench(signatures, getNumberOption<unsigned long long>(args, "--samples", 1000000));
+    }
+
+    if (!args.empty() && args[0] == "--batch-sim") {
+        BatchConfig config;
+        config.games = getNumberOption<unsigned long long>(args, "--games", 100000);
+        config.lanes = getNumberOption<unsigned long>(args, "--lanes", 1024);
+        config.maxPlies = getNumberOption<int>(args, "--plies", 200);
+        config.policy = getOption(args, "--policy", "random") == "greedy" ? BatchPolicy::GREEDY : BatchPolicy::RANDOM;
+        config.seed = getNumberOption<unsigned long>(args, "--seed", 1);
+        config.threads = getNumberOption<int>(args, "--threads", 1);
+        config.sequentialGames = getNumberOption<unsigned long long>(args, "--sequential", 20000);
+        config.checkedLanes = getNumberOption<unsigned long>(args, "--check", 0);
+        return runBatchSimulation(config);
+    }
+
+    if (!args.empty() && args[0] == "--event-bench") {
+        return runEventLogBench(args.size() >= 2 && args[1].rfind("--", 0) != 0 ? args[1] : "events.log",
+            getNumberOption<int>(args, "--games", 2000),
+            getNumberOption<unsigned long>(args, "--ring", EventLog::defaultRingCapacity));
+    }
+
+    if (!args.empty() && args[0] == "--hub") {
+        std::ios::sync_with_stdio(false);
+        HubEngine engine(std::cin, stdout);
+        return engine.run();
+    }
+
+    if (args.size() >= 3 && args[0] == "--analyze") {
+        AnalyzerConfig config;
+        config.inputPath = args[1];
+        config.outputPath = args[2];
+        config.limits.moveTimeMs = getNumberOption<int>(args, "--time", 0);
+        //  --depth  --time   :   10,  --depth -  
+        config.limits.depth = getNumberOption<int>(args, "--depth", config.limits.moveTimeMs > 0 ? 64 : 10);
+        config.multiPV = getNumberOption<int>(args, "--multipv", 3);
+        config.threads = getNumberOption<int>(args, "--threads", 0);
+        return BatchAnalyzer(config).run();
+    }
+
+    if (args.size() >= 2 && args[0] == "--solve") {
+        SolverConfig config;
+        config.memoryMb = getNumberOption<unsigned long>(args, "--memory", 256);
+        config.threads = getNumberOption<int>(args, "--threads", 1);
+        config.timeMs = getNumberOption<int>(args, "--time", 0);
+        return runSolver(args[1], config);
+    }
+
+    if (args.size() >= 3 && args[0] == "--perft") {
+        return runPerft(args[1], parseNumber<int>(args[2], "depth"), args.size() >= 4 ? args[3] : "");
+    }
 
     //  
     Player* player1 = new HumanPlayer("Player 1", PieceColor::WHITE);
@@ -12,6 +192,13 @@ int main() {
     //  
     Game game(player1, player2, true);
 
+    //    ,   --events (  ,    )
+    EventLog events;
+    std::string eventsPath = getOption(args, "--events", "");
+    if (!eventsPath.empty() && events.open(eventsPath)) {
+        game.setEventLog(events.attach(), 1);
+    }
+
     //  
     game.start();
 
@@ -0,0 +1,117 @@
+#include "MoveGen.h"
+
+namespace {
+
+//   :   ,    
+constexpr const BoardGeometry<8>::Table& table = BoardGeometry<8>::table;
+
+inline uint32_t bit(int sq) { return 1u << sq; }
+
+using HouseMoveGen = VariantMoveGen<HouseRules>;
+
+HouseMoveGen::Position toHouse(const Position& position) {
+    HouseMoveGen::Position house;
+    house.white = position.white;
+    house.black = position.black;
+    house.kings = position.kings;
+    house.sideToMove = position.sideToMove;
+    return house;
+}
+
+} // namespace
+
+int MoveGen::neighbor(int sq, int direction) {
+    return table.next[sq][direction];
+}
+
+bool MoveGen::hasCapture(const Position& position) {
+    return HouseMoveGen::hasCapture(toHouse(position));
+}
+
+void MoveGen::generate(const Position& position, MoveList& list) {
+    HouseMoveGen::generate(toHouse(position), list);
+}
+
+Position MoveGen::apply(const Position& position, const Move& move) {
+    HouseMoveGen::Position house = HouseMoveGen::apply(toHouse(position), move);
+    Position next;
+    next.white = house.white;
+    next.black = house.black;
+    next.kings = house.kings;
+    next.sideToMove = house.sideToMove;
+    return next;
+}
+
+std::string MoveGen::toString(const Move& move) {
+    return HouseMoveGen::toString(move);
+}
+
+bool MoveGen::parse(const Position& position, const std::string& text, Move& move) {
+    int squares[16];
+    int count = 0;
+    int value = -1;
+    for (size_t i = 0; i <= text.size(); ++i) {
+        char c = i < text.size() ? text[i] : '\0';
+        if (c >= '0' && c <= '9') {
+            value = (value < 0 ? 0 : value * 10) + (c - '0');
+        }
+        else if (c == '-' || c == 'x' || c == 'X' || c == ':' || c == '\0') {
+            if (value < 1 || value > 32 || count == 16) return false;
+            squares[count++] = value - 1;
+            value = -1;
+        }
+        else {
+            return false;
+        }
+    }
+    if (count < 2) return false;
+
+    MoveList list;
+    generate(position, list);
+    int matches = 0;
+    for (int i = 0; i < list.count; ++i) {
+        const Move& candidate = list.moves[i];
+        if (candidate.from != squares[0] || candidate.to != squares[count - 1]) continue;
+        if (count > 2) {
+            //    -   
+            if (candidate.pathLength != count - 1) continue;
+            bool same = true;
+            for (int j = 0; j < candidate.pathLength; ++j) {
+                same = same && candidate.path[j] == squares[j + 1];
+            }
+            if (!same) continue;
+        }
+        if (matches++ == 0) {
+            move = candidate;
+        }
+    }
+    return matches == 1;
+}
+
+bool MoveGen::fromSquares(const Position& position, const uint8_t* squares, int count, Move& move) {
+    if (count < 2 || count > 14 || squares[0] >= 32 || !(position.own() & bit(squares[0]))) {
+        return false;
+    }
+    move = Move();
+    move.from = squares[0];
+    int from = move.from;
+    for (int i = 1; i < count; ++i) {
+        int to = squares[i];
+        if (to >= 32) return false;
+        int rowDiff = Position::rowOf(to) - Position::rowOf(from);
+        int colDiff = Position::colOf(to) - Position::colOf(from);
+        if (rowDiff == 0 || (rowDiff > 0 ? rowDiff : -rowDiff) != (colDiff > 0 ? colDiff : -colDiff)) return false;
+        int direction = (rowDiff > 0 ? 0 : 2) + (colDiff > 0 ? 1 : 0);
+        for (int sq = table.next[from][direction]; sq != to; sq = table.next[sq][direction]) {
+            if (sq < 0) return false;
+            move.captured |= position.enemy() & bit(sq);
+        }
+        move.path[move.pathLength++] = static_cast<uint8_t>(to);
+        from = to;
+    }
+    move.to = static_cast<uint8_t>(from);
+    bool king = (position.kings & bit(move.from)) != 0;
+    uint32_t promotionRow = position.sideToMove == PieceColor::WHITE ? 0xF0000000u : 0x0000000Fu;
+    move.promotes = !king && (promotionRow & bit(move.to));
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "Position.h"
+#include "VariantMoveGen.h"
+#include <cstdint>
+#include <string>
+
+//   (  ): path -    ,  = to,
+// captured -   .     -  ,   VariantMoveGen<HouseRules>:
+// MoveGen -     Position,      .
+using Move = VariantMove<HouseRules>;
+using MoveList = VariantMoveList<HouseRules>;
+
+//     Game/Board:  ,   , 
+// ,    ,     ,
+//      (HouseRules).   VariantMoveGen<HouseRules>.
+class MoveGen {
+public:
+    static void generate(const Position& position, MoveList& list);
+    static bool hasCapture(const Position& position);
+    static Position apply(const Position& position, const Move& move);
+
+    //  : "9-13"   , "9x18x25"   (  )
+    static std::string toString(const Move& move);
+    //    ,    (   "from x to",
+    //    ). false,   .
+    static bool parse(const Position& position, const std::string& text, Move& move);
+    //   : squares[0] -  ,    (   
+    //  ).   -     ,  - 
+    //  .    (     ); false,
+    //        :      .
+    static bool fromSquares(const Position& position, const uint8_t* squares, int count, Move& move);
+
+    //      -1. : 0/1 -  ( +1), 2/3 - .
+    static int neighbor(int sq, int direction);
+};
+
+#endif
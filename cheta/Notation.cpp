@@ -0,0 +1,234 @@
+#include "Notation.h"
+#include <cstring>
+
+bool PackedPosition::operator==(const PackedPosition& other) const {
+    return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+}
+
+namespace {
+
+int countBits(uint32_t mask) {
+    int count = 0;
+    for (; mask; mask &= mask - 1) ++count;
+    return count;
+}
+
+//   1..32.  ,     32,  
+//     int
+bool parseSquareNumber(const char*& p, const char* end, int& value) {
+    const char* start = p;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+        if (value > 32) return false;
+    }
+    return p != start && value >= 1;
+}
+
+//       ':'   
+bool parseSquares(const char*& p, const char* end, uint32_t& pieces, uint32_t& kings) {
+    while (p < end && *p != ':') {
+        bool king = false;
+        if (*p == 'K') {
+            king = true;
+            ++p;
+        }
+        int first = 0;
+        if (!parseSquareNumber(p, end, first)) return false;
+        int last = first;
+        if (p < end && *p == '-') {
+            ++p;
+            if (!parseSquareNumber(p, end, last) || last < first) return false;
+        }
+        for (int square = first; square <= last; ++square) {
+            pieces |= 1u << (square - 1);
+            if (king) kings |= 1u << (square - 1);
+        }
+        if (p < end && *p == ',') {
+            ++p;
+            if (p == end || *p == ':') return false; //   
+        }
+        else if (p < end && *p != ':') {
+            return false;
+        }
+    }
+    return true;
+}
+
+//   :        
+char* writeSquares(char* out, uint32_t pieces, uint32_t kings) {
+    bool first = true;
+    int square = 0;
+    while (square < 32) {
+        uint32_t bit = 1u << square;
+        if (!(pieces & bit)) {
+            ++square;
+            continue;
+        }
+        bool king = (kings & bit) != 0;
+        int last = square;
+        while (last + 1 < 32 && (pieces & (1u << (last + 1))) && (((kings >> (last + 1)) & 1u) != 0) == king) ++last;
+        if (last - square < 2) last = square; //      
+        if (!first) *out++ = ',';
+        first = false;
+        if (king) *out++ = 'K';
+        int number = square + 1;
+        if (number >= 10) *out++ = static_cast<char>('0' + number / 10);
+        *out++ = static_cast<char>('0' + number % 10);
+        if (last != square) {
+            *out++ = '-';
+            number = last + 1;
+            if (number >= 10) *out++ = static_cast<char>('0' + number / 10);
+            *out++ = static_cast<char>('0' + number % 10);
+        }
+        square = last + 1;
+    }
+    return out;
+}
+
+//          :  -  7,  -  0
+bool hasUnpromotedMen(const Position& position) {
+    const uint32_t whitePromotionRow = 0xF0000000u;
+    const uint32_t blackPromotionRow = 0x0000000Fu;
+    return ((position.white & ~position.kings & whitePromotionRow) | (position.black & ~position.kings & blackPromotionRow)) != 0;
+}
+
+} // namespace
+
+bool Notation::parse(const char* text, size_t length, Position& position) {
+    // ,      (   [FEN "..."])  
+    while (length > 0 && (*text == ' ' || *text == '"')) {
+        ++text;
+        --length;
+    }
+    while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '"' || text[length - 1] == '.' ||
+        text[length - 1] == '\r' || text[length - 1] == '\n')) {
+        --length;
+    }
+    if (length == 33 && std::memchr(text, ':', length) == nullptr) {
+        return parseHub(text, length, position);
+    }
+    if (length < 1 || (text[0] != 'W' && text[0] != 'B')) {
+        return false;
+    }
+
+    Position parsed;
+    parsed.sideToMove = text[0] == 'W' ? PieceColor::WHITE : PieceColor::BLACK;
+    const char* p = text + 1;
+    const char* end = text + length;
+    while (p < end) {
+        if (*p++ != ':' || p == end || (*p != 'W' && *p != 'B')) return false;
+        bool white = *p++ == 'W';
+        uint32_t pieces = 0;
+        uint32_t kings = 0;
+        if (!parseSquares(p, end, pieces, kings)) return false;
+        if (pieces & parsed.occupied()) return false; //   
+        (white ? parsed.white : parsed.black) |= pieces;
+        parsed.kings |= kings;
+    }
+    if (countBits(parsed.occupied()) > 24) {
+        return false; //  ,     (   PackedPosition)
+    }
+    if (hasUnpromotedMen(parsed)) {
+        return false;
+    }
+    position = parsed;
+    return true;
+}
+
+size_t Notation::write(const Position& position, char* buffer, size_t capacity) {
+    char local[maxLength];
+    char* out = local;
+    *out++ = position.sideToMove == PieceColor::WHITE ? 'W' : 'B';
+    *out++ = ':';
+    *out++ = 'W';
+    out = writeSquares(out, position.white, position.kings);
+    *out++ = ':';
+    *out++ = 'B';
+    out = writeSquares(out, position.black, position.kings);
+    size_t length = static_cast<size_t>(out - local);
+    if (length > capacity) {
+        return 0;
+    }
+    std::memcpy(buffer, local, length);
+    return length;
+}
+
+std::string Notation::toString(const Position& position) {
+    char buffer[maxLength];
+    return std::string(buffer, write(position, buffer, sizeof(buffer)));
+}
+
+bool Notation::parseHub(const char* text, size_t length, Position& position) {
+    if (length != 33 || (text[0] != 'W' && text[0] != 'B')) {
+        return false;
+    }
+    Position parsed;
+    parsed.sideToMove = text[0] == 'W' ? PieceColor::WHITE : PieceColor::BLACK;
+    for (int sq = 0; sq < 32; ++sq) {
+        uint32_t bit = 1u << sq;
+        switch (text[sq + 1]) {
+        case 'e': break;
+        case 'w': parsed.white |= bit; break;
+        case 'b': parsed.black |= bit; break;
+        case 'W': parsed.white |= bit; parsed.kings |= bit; break;
+        case 'B': parsed.black |= bit; parsed.kings |= bit; break;
+        default: return false;
+        }
+    }
+    if (countBits(parsed.occupied()) > 24 || hasUnpromotedMen(parsed)) {
+        return false;
+    }
+    position = parsed;
+    return true;
+}
+
+std::string Notation::toHubString(const Position& position) {
+    std::string text(33, 'e');
+    text[0] = position.sideToMove == PieceColor::WHITE ? 'W' : 'B';
+    for (int sq = 0; sq < 32; ++sq) {
+        uint32_t bit = 1u << sq;
+        bool king = (position.kings & bit) != 0;
+        if (position.white & bit) text[sq + 1] = king ? 'W' : 'w';
+        else if (position.black & bit) text[sq + 1] = king ? 'B' : 'b';
+    }
+    return text;
+}
+
+PackedPosition Notation::pack(const Position& position) {
+    uint32_t occupied = position.occupied();
+    uint32_t colors = 0;
+    uint32_t kings = 0;
+    int index = 0;
+    for (uint32_t pieces = occupied; pieces && index < 24; pieces &= pieces - 1, ++index) {
+        uint32_t bit = pieces & (0u - pieces);
+        if (position.white & bit) colors |= 1u << index;
+        if (position.kings & bit) kings |= 1u << index;
+    }
+    PackedPosition packed;
+    for (int i = 0; i < 4; ++i) packed.bytes[i] = static_cast<uint8_t>(occupied >> (8 * i));
+    for (int i = 0; i < 3; ++i) packed.bytes[4 + i] = static_cast<uint8_t>(colors >> (8 * i));
+    for (int i = 0; i < 3; ++i) packed.bytes[7 + i] = static_cast<uint8_t>(kings >> (8 * i));
+    packed.bytes[10] = position.sideToMove == PieceColor::WHITE ? 0 : 1;
+    return packed;
+}
+
+Position Notation::unpack(const PackedPosition& packed) {
+    uint32_t occupied = 0;
+    uint32_t colors = 0;
+    uint32_t kings = 0;
+    for (int i = 0; i < 4; ++i) occupied |= static_cast<uint32_t>(packed.bytes[i]) << (8 * i);
+    for (int i = 0; i < 3; ++i) colors |= static_cast<uint32_t>(packed.bytes[4 + i]) << (8 * i);
+    for (int i = 0; i < 3; ++i) kings |= static_cast<uint32_t>(packed.bytes[7 + i]) << (8 * i);
+
+    Position position;
+    position.sideToMove = packed.bytes[10] == 0 ? PieceColor::WHITE : PieceColor::BLACK;
+    int index = 0;
+    for (uint32_t pieces = occupied; pieces && index < 24; pieces &= pieces - 1, ++index) {
+        uint32_t bit = pieces & (0u - pieces);
+        if ((colors >> index) & 1u) position.white |= bit;
+        else position.black |= bit;
+        if ((kings >> index) & 1u) position.kings |= bit;
+    }
+    return position;
+}
@@ -0,0 +1,43 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//  , 11 :    (4 ),   
+//   (3 , 1 - ),    (3 ),   (1 ).
+//     24 ,  24      .
+struct PackedPosition {
+    uint8_t bytes[11];
+
+    bool operator==(const PackedPosition& other) const;
+};
+
+//      PDN FEN: "W:W1-12:B21-32"  "B:W18,K30:B3,K12".
+//   -  ,       (1..32,  
+// MoveGen::toString), K   - , "a-b" -  .
+//           .
+class Notation {
+public:
+    static const size_t maxLength = 160; //    
+
+    //  FEN  33-   Hub. false  
+    // ( position  ).
+    static bool parse(const char* text, size_t length, Position& position);
+    static bool parse(const std::string& text, Position& position) { return parse(text.data(), text.size(), position); }
+
+    //  FEN  buffer (  ),    0,   
+    static size_t write(const Position& position, char* buffer, size_t capacity);
+    static std::string toString(const Position& position);
+
+    //  Hub:    32    (e - , w/b - , W/B - )
+    static bool parseHub(const char* text, size_t length, Position& position);
+    static std::string toHubString(const Position& position);
+
+    static PackedPosition pack(const Position& position);
+    static Position unpack(const PackedPosition& packed);
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "Player.h"
 #include <iostream>
+#include <limits>
 
 Player::Player(const std::string& name, PieceColor color) : name(name), color(color) {}
 
@@ -45,4 +46,10 @@ std::pair<std::pair<int, int>, std::pair<int, int>> HumanPlayer::getMove(const B
     }
     //   
     return { {fromRow, fromCol}, {toRow, toCol} };
+}
+
+RemotePlayer::RemotePlayer(const std::string& name, PieceColor color) : Player(name, color) {}
+
+std::pair<std::pair<int, int>, std::pair<int, int>> RemotePlayer::getMove(const Board&) {
+    return { {-1, -1}, {-1, -1} };
 }
\ No newline at end of file
@@ -28,4 +28,12 @@ public:
     std::pair<std::pair<int, int>, std::pair<int, int>> getMove(const Board& board) override;
 };
 
+//,     ( ,  )  Game::applyStep.
+//   : getMove   (-1, -1).
+class RemotePlayer : public Player {
+public:
+    RemotePlayer(const std::string& name, PieceColor color);
+    std::pair<std::pair<int, int>, std::pair<int, int>> getMove(const Board& board) override;
+};
+
 #endif
\ No newline at end of file
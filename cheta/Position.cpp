@@ -0,0 +1,51 @@
+#include "Position.h"
+#include "Board.h"
+
+Position Position::fromBoard(const Board& board, PieceColor sideToMove) {
+    Position position;
+    position.sideToMove = sideToMove;
+    for (int sq = 0; sq < 32; ++sq) {
+        Piece* piece = board.getPiece(rowOf(sq), colOf(sq));
+        if (!piece) continue;
+        uint32_t bit = 1u << sq;
+        if (piece->getColor() == PieceColor::WHITE) position.white |= bit;
+        else position.black |= bit;
+        if (piece->isKing()) position.kings |= bit;
+    }
+    return position;
+}
+
+Position Position::initial() {
+    Position position;
+    position.white = 0x00000FFFu; //  0..2
+    position.black = 0xFFF00000u; //  5..7
+    return position;
+}
+
+void Position::toBoard(Board& board) const {
+    for (int row = 0; row < board.getBoardSize(); ++row) {
+        for (int col = 0; col < board.getBoardSize(); ++col) {
+            board.removePiece(row, col);
+        }
+    }
+    for (int sq = 0; sq < 32; ++sq) {
+        uint32_t bit = 1u << sq;
+        if (!((white | black) & bit)) continue;
+        PieceColor color = (white & bit) ? PieceColor::WHITE : PieceColor::BLACK;
+        board.setPiece(rowOf(sq), colOf(sq), new Piece(color, (kings & bit) ? PieceType::KING : PieceType::MAN));
+    }
+}
+
+//  splitmix64:     ,   
+static uint64_t mix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+uint64_t Position::hash() const {
+    uint64_t h = mix((static_cast<uint64_t>(white) << 32) | black);
+    h = mix(h ^ kings);
+    return sideToMove == PieceColor::WHITE ? h : ~h;
+}
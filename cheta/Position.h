@@ -0,0 +1,36 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "Enums.h"
+#include <cstdint>
+
+class Board;
+
+//    :    32  .
+//   sq = row * 4 + col / 2 ( 0..7   Board,     ).
+//       : sq + 1.
+struct Position {
+    uint32_t white = 0;
+    uint32_t black = 0;
+    uint32_t kings = 0; //  white | black
+    PieceColor sideToMove = PieceColor::WHITE;
+
+    static Position fromBoard(const Board& board, PieceColor sideToMove);
+    static Position initial();
+    void toBoard(Board& board) const; //     
+
+    uint32_t own() const { return sideToMove == PieceColor::WHITE ? white : black; }
+    uint32_t enemy() const { return sideToMove == PieceColor::WHITE ? black : white; }
+    uint32_t occupied() const { return white | black; }
+    uint64_t hash() const;
+
+    bool operator==(const Position& other) const {
+        return white == other.white && black == other.black && kings == other.kings && sideToMove == other.sideToMove;
+    }
+
+    static int square(int row, int col) { return ((row + col) % 2 == 1) ? row * 4 + col / 2 : -1; } // -1   
+    static int rowOf(int sq) { return sq / 4; }
+    static int colOf(int sq) { return (sq / 4) % 2 == 0 ? (sq % 4) * 2 + 1 : (sq % 4) * 2; }
+};
+
+#endif
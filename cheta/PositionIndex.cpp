@@ -0,0 +1,234 @@
+#include "PositionIndex.h"
+#include <bit>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+namespace {
+
+const uint32_t rowZero = 0x0000000Fu;      //   
+const uint32_t lastRow = 0xF0000000u;      //   
+const uint32_t middleSquares = ~(rowZero | lastRow);
+const uint32_t blackMenSquares = ~rowZero;
+
+struct BinomialTable {
+    uint64_t value[33][33] = {};
+
+    constexpr BinomialTable() {
+        for (int n = 0; n <= 32; ++n) {
+            value[n][0] = 1;
+            for (int k = 1; k <= n; ++k) {
+                value[n][k] = value[n - 1][k - 1] + (k <= n - 1 ? value[n - 1][k] : 0);
+            }
+        }
+    }
+};
+
+constexpr BinomialTable binomial;
+
+uint64_t choose(int n, int k) {
+    return (n < 0 || k < 0 || k > n) ? 0 : binomial.value[n][k];
+}
+
+//   subset   domain   :  C(p_i, i),
+// p_i -  i-     domain
+inline uint64_t subsetRank(uint32_t subset, uint32_t domain) {
+    uint64_t rank = 0;
+    for (int i = 1; subset; subset &= subset - 1, ++i) {
+        uint32_t below = (subset & (0u - subset)) - 1;
+        rank += binomial.value[std::popcount(domain & below)][i];
+    }
+    return rank;
+}
+
+//   subsetRank: count  domain   rank
+inline uint32_t subsetUnrank(uint64_t rank, int count, uint32_t domain) {
+    uint8_t squares[32];
+    int size = 0;
+    for (uint32_t rest = domain; rest; rest &= rest - 1) {
+        squares[size++] = static_cast<uint8_t>(std::countr_zero(rest));
+    }
+    uint32_t subset = 0;
+    int place = size;
+    for (int i = count; i >= 1; --i) {
+        //     -    C(place, i) <= rank
+        do {
+            --place;
+        } while (binomial.value[place][i] > rank);
+        rank -= binomial.value[place][i];
+        subset |= 1u << squares[place];
+    }
+    return subset;
+}
+
+//    : 0,     64 
+uint64_t multiply(uint64_t a, uint64_t b) {
+    if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a) return 0;
+    return a * b;
+}
+
+} // namespace
+
+MaterialSignature MaterialSignature::of(const Position& position)
+{
+    MaterialSignature signature;
+    signature.whiteMen = std::popcount(position.white & ~position.kings);
+    signature.whiteKings = std::popcount(position.white & position.kings);
+    signature.blackMen = std::popcount(position.black & ~position.kings);
+    signature.blackKings = std::popcount(position.black & position.kings);
+    return signature;
+}
+
+PositionIndexer::PositionIndexer(const MaterialSignature& signature) : signature(signature), total(0)
+{
+    int men = signature.whiteMen + signature.blackMen;
+    whiteKingCount = choose(32 - men, signature.whiteKings);
+    blackKingCount = choose(32 - men - signature.whiteKings, signature.blackKings);
+    bool overflow = false;
+    for (int k = 0; k < maxSlices; ++k) {
+        rowZeroCount[k] = choose(4, k);
+        middleCount[k] = choose(24, signature.whiteMen - k);
+        blackMenCount[k] = choose(28 - (signature.whiteMen - k), signature.blackMen);
+        if (signature.whiteMen < k) {
+            blackMenCount[k] = 0;
+        }
+        uint64_t size = rowZeroCount[k];
+        for (uint64_t factor : { middleCount[k], blackMenCount[k], whiteKingCount, blackKingCount }) {
+            uint64_t product = multiply(size, factor);
+            overflow = overflow || (product == 0 && size != 0 && factor != 0);
+            size = product;
+        }
+        sliceStart[k] = total;
+        overflow = overflow || total + size < total;
+        total += size;
+    }
+    sliceStart[maxSlices] = total;
+    if (overflow || signature.whiteMen < 0 || signature.whiteKings < 0 || signature.blackMen < 0 || signature.blackKings < 0) {
+        total = 0; //     64    
+        for (uint64_t& start : sliceStart) {
+            start = 0;
+        }
+    }
+}
+
+bool PositionIndexer::contains(const Position& position) const
+{
+    uint32_t whiteMen = position.white & ~position.kings;
+    uint32_t blackMen = position.black & ~position.kings;
+    return total != 0 && (position.white & position.black) == 0 && (position.kings & ~(position.white | position.black)) == 0 &&
+        (whiteMen & lastRow) == 0 && (blackMen & rowZero) == 0 && MaterialSignature::of(position) == signature;
+}
+
+uint64_t PositionIndexer::rank(const Position& position) const
+{
+    uint32_t whiteMen = position.white & ~position.kings;
+    uint32_t blackMen = position.black & ~position.kings;
+    uint32_t whiteKings = position.white & position.kings;
+    uint32_t blackKings = position.black & position.kings;
+    uint32_t middle = whiteMen & middleSquares;
+    uint32_t free = ~(whiteMen | blackMen);
+    int slice = std::popcount(whiteMen & rowZero);
+
+    uint64_t index = subsetRank(whiteMen & rowZero, rowZero);
+    index = index * middleCount[slice] + subsetRank(middle, middleSquares);
+    index = index * blackMenCount[slice] + subsetRank(blackMen, blackMenSquares & ~middle);
+    index = index * whiteKingCount + subsetRank(whiteKings, free);
+    index = index * blackKingCount + subsetRank(blackKings, free & ~whiteKings);
+    return sliceStart[slice] + index;
+}
+
+Position PositionIndexer::unrank(uint64_t index, PieceColor sideToMove) const
+{
+    int slice = 0;
+    while (slice + 1 < maxSlices && index >= sliceStart[slice + 1]) {
+        ++slice;
+    }
+    index -= sliceStart[slice];
+
+    //      :  ,  , ...
+    uint64_t blackKingRank = index % blackKingCount;
+    index /= blackKingCount;
+    uint64_t whiteKingRank = index % whiteKingCount;
+    index /= whiteKingCount;
+    uint64_t blackMenRank = index % blackMenCount[slice];
+    index /= blackMenCount[slice];
+    uint64_t middleRank = index % middleCount[slice];
+    uint64_t rowZeroRank = index / middleCount[slice];
+
+    uint32_t middle = subsetUnrank(middleRank, signature.whiteMen - slice, middleSquares);
+    uint32_t whiteMen = subsetUnrank(rowZeroRank, slice, rowZero) | middle;
+    uint32_t blackMen = subsetUnrank(blackMenRank, signature.blackMen, blackMenSquares & ~middle);
+    uint32_t free = ~(whiteMen | blackMen);
+    uint32_t whiteKings = subsetUnrank(whiteKingRank, signature.whiteKings, free);
+    uint32_t blackKings = subsetUnrank(blackKingRank, signature.blackKings, free & ~whiteKings);
+
+    Position position;
+    position.white = whiteMen | whiteKings;
+    position.black = blackMen | blackKings;
+    position.kings = whiteKings | blackKings;
+    position.sideToMove = sideToMove;
+    return position;
+}
+
+int runIndexBench(const std::string& signatures, uint64_t samples)
+{
+    std::istringstream list(signatures);
+    std::string text;
+    bool failed = false;
+    std::printf("%-10s %22s %12s %12s %10s\n", "material", "positions", "rank ns", "unrank ns", "errors");
+    while (list >> text) {
+        MaterialSignature signature;
+        if (std::sscanf(text.c_str(), "%d,%d,%d,%d", &signature.whiteMen, &signature.whiteKings,
+            &signature.blackMen, &signature.blackKings) != 4) {
+            std::cerr << "Bad material " << text << " (expected whiteMen,whiteKings,blackMen,blackKings)" << std::endl;
+            return 1;
+        }
+        PositionIndexer indexer(signature);
+        if (indexer.count() == 0) {
+            std::printf("%-10s %22s\n", text.c_str(), "impossible or > 2^64");
+            continue;
+        }
+
+        //  ,     samples,  . ,  
+        // rank  unrank ,    .
+        bool exhaustive = indexer.count() <= samples;
+        uint64_t total = exhaustive ? indexer.count() : samples;
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<uint64_t> pick(0, indexer.count() - 1);
+        const int blockSize = 4096;
+        uint64_t indices[blockSize];
+        Position positions[blockSize];
+        double rankNs = 0, unrankNs = 0;
+        uint64_t errors = 0;
+        for (uint64_t done = 0; done < total; done += blockSize) {
+            int block = static_cast<int>(std::min<uint64_t>(blockSize, total - done));
+            for (int i = 0; i < block; ++i) {
+                indices[i] = exhaustive ? done + i : pick(rng);
+            }
+            auto started = std::chrono::steady_clock::now();
+            for (int i = 0; i < block; ++i) {
+                positions[i] = indexer.unrank(indices[i]);
+            }
+            auto middle = std::chrono::steady_clock::now();
+            uint64_t mismatches = 0;
+            for (int i = 0; i < block; ++i) {
+                mismatches += indexer.rank(positions[i]) != indices[i];
+            }
+            auto finished = std::chrono::steady_clock::now();
+            unrankNs += std::chrono::duration<double, std::nano>(middle - started).count();
+            rankNs += std::chrono::duration<double, std::nano>(finished - middle).count();
+            errors += mismatches;
+            for (int i = 0; i < block; ++i) {
+                errors += !indexer.contains(positions[i]);
+            }
+        }
+        std::printf("%-10s %22llu %12.1f %12.1f %10llu%s\n", text.c_str(), static_cast<unsigned long long>(indexer.count()),
+            rankNs / total, unrankNs / total, static_cast<unsigned long long>(errors), exhaustive ? "" : " (sampled)");
+        failed = failed || errors != 0;
+    }
+    return failed ? 1 : 0;
+}
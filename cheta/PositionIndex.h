@@ -0,0 +1,67 @@
+#ifndef POSITION_INDEX_H
+#define POSITION_INDEX_H
+
+#include "Position.h"
+#include <cstdint>
+#include <string>
+
+//  :      
+struct MaterialSignature {
+    int whiteMen = 0;
+    int whiteKings = 0;
+    int blackMen = 0;
+    int blackKings = 0;
+
+    static MaterialSignature of(const Position& position);
+    int pieces() const { return whiteMen + whiteKings + blackMen + blackKings; }
+    bool operator==(const MaterialSignature& other) const {
+        return whiteMen == other.whiteMen && whiteKings == other.whiteKings &&
+            blackMen == other.blackMen && blackKings == other.blackKings;
+    }
+};
+
+//        [0, count())  
+//  ( , )      -.
+//
+//         :  -   0..27,
+//  -  4..31.       (
+// k-  -  C(p_i, i)   )   :
+//       0 |     4..27 |    4..31 
+//     |      |    .
+//      ,       0, 
+//       .       (
+//     ): rank   , unrank  .
+//
+// rank  unrank         ,    .
+class PositionIndexer {
+public:
+    explicit PositionIndexer(const MaterialSignature& signature);
+
+    const MaterialSignature& getSignature() const { return signature; }
+    uint64_t count() const { return total; }
+
+    //   :            
+    bool contains(const Position& position) const;
+    //  .    (contains),    .
+    uint64_t rank(const Position& position) const;
+    Position unrank(uint64_t index, PieceColor sideToMove = PieceColor::WHITE) const;
+
+private:
+    static const int maxSlices = 5; //     0:  0  4
+
+    MaterialSignature signature;
+    uint64_t total;
+    uint64_t sliceStart[maxSlices + 1];
+    uint64_t rowZeroCount[maxSlices];  //  k     0
+    uint64_t middleCount[maxSlices];   //      4..27
+    uint64_t blackMenCount[maxSlices]; //      4..31
+    uint64_t whiteKingCount;
+    uint64_t blackKingCount;
+};
+
+//   :    ( "2,1,2,0" -  ,  ,
+//  ,  ) -  ,   unrank -> rank  .
+//    main.
+int runIndexBench(const std::string& signatures, uint64_t samples);
+
+#endif
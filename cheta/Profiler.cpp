@@ -0,0 +1,216 @@
+#include "Profiler.h"
+
+#ifdef CHETA_INSTRUMENT
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int pointCount = static_cast<int>(ProfilePoint::COUNT);
+
+const char* pointNames[pointCount] = {
+    "getPiece", "getPieceColor", "isInsideBoard", "initialize", "isValidMove", "isJumpPossible",
+    "isRegularMovePossible", "canJumpFrom", "getPossibleMoves", "getRequiredJumps", "hasRequiredJumps",
+    "makeMove", "setPiece", "clearPiece", "removePiece", "Game::applyStep", "Game::checkGameEnd"
+};
+
+//   .  :      .
+struct ThreadCounters {
+    uint64_t calls[pointCount] = {};
+    uint64_t nanoseconds[pointCount] = {};
+    uint64_t allocations[pointCount] = {};
+    uint64_t moves = 0;
+    uint64_t moveAllocations = 0;
+    uint64_t maxMoveAllocations = 0;
+    uint64_t lastMoveAllocations = 0; //  allocationCount    
+    uint64_t allocatedBytes = 0;      //  allocationBytes   
+};
+
+//  thread_local  : operator new    
+thread_local uint64_t allocationCount = 0;
+thread_local uint64_t allocationBytes = 0;
+thread_local ThreadCounters* threadCounters = nullptr;
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadCounters*> threads;
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry(); //   ,    
+    return *instance;
+}
+
+ThreadCounters& counters() {
+    if (!threadCounters) {
+        ThreadCounters* created = new ThreadCounters();
+        created->lastMoveAllocations = allocationCount; //        
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(created);
+        threadCounters = created;
+    }
+    return *threadCounters;
+}
+
+void writeDefaultReport() {
+    const char* path = std::getenv("CHETA_PROFILE");
+    if (!path || !*path) {
+        Profiler::writeReport(std::cerr, false);
+        return;
+    }
+    std::string name(path);
+    bool json = name.size() >= 5 && name.compare(name.size() - 5, 5, ".json") == 0;
+    std::ofstream out(name);
+    if (!out) {
+        std::cerr << "Cannot write profile to " << name << std::endl;
+        return;
+    }
+    Profiler::writeReport(out, json);
+}
+
+//     main
+struct ReportAtExit {
+    ~ReportAtExit() { writeDefaultReport(); }
+} reportAtExit;
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    allocationBytes += size;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void Profiler::count(ProfilePoint point) {
+    ++counters().calls[static_cast<int>(point)];
+}
+
+void Profiler::record(ProfilePoint point, int64_t nanoseconds, uint64_t allocations) {
+    ThreadCounters& c = counters();
+    int index = static_cast<int>(point);
+    ++c.calls[index];
+    c.nanoseconds[index] += static_cast<uint64_t>(nanoseconds);
+    c.allocations[index] += allocations;
+    c.allocatedBytes = allocationBytes;
+}
+
+void Profiler::endMove() {
+    ThreadCounters& c = counters();
+    uint64_t made = allocationCount - c.lastMoveAllocations;
+    c.lastMoveAllocations = allocationCount;
+    ++c.moves;
+    c.moveAllocations += made;
+    c.maxMoveAllocations = std::max(c.maxMoveAllocations, made);
+    c.allocatedBytes = allocationBytes;
+}
+
+uint64_t Profiler::allocations() {
+    return allocationCount;
+}
+
+void Profiler::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (ThreadCounters* c : r.threads) {
+        uint64_t last = c->lastMoveAllocations;
+        uint64_t bytes = c->allocatedBytes;
+        *c = ThreadCounters();
+        c->lastMoveAllocations = last;
+        c->allocatedBytes = bytes;
+    }
+}
+
+void Profiler::writeReport(std::ostream& out, bool json) {
+    //   .      -  .
+    ThreadCounters total;
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const ThreadCounters* c : r.threads) {
+            for (int i = 0; i < pointCount; ++i) {
+                total.calls[i] += c->calls[i];
+                total.nanoseconds[i] += c->nanoseconds[i];
+                total.allocations[i] += c->allocations[i];
+            }
+            total.moves += c->moves;
+            total.moveAllocations += c->moveAllocations;
+            total.maxMoveAllocations = std::max(total.maxMoveAllocations, c->maxMoveAllocations);
+            total.allocatedBytes += c->allocatedBytes;
+        }
+    }
+
+    //    - 
+    std::vector<int> order;
+    for (int i = 0; i < pointCount; ++i) {
+        if (total.calls[i] != 0) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&total](int a, int b) {
+        return total.nanoseconds[a] != total.nanoseconds[b] ? total.nanoseconds[a] > total.nanoseconds[b] : total.calls[a] > total.calls[b];
+    });
+    double perMove = total.moves ? static_cast<double>(total.moveAllocations) / total.moves : 0.0;
+
+    if (json) {
+        out << "{\n  \"functions\": [\n";
+        for (size_t k = 0; k < order.size(); ++k) {
+            int i = order[k];
+            out << "    {\"name\": \"" << pointNames[i] << "\", \"calls\": " << total.calls[i]
+                << ", \"totalNs\": " << total.nanoseconds[i]
+                << ", \"nsPerCall\": " << (total.nanoseconds[i] / total.calls[i])
+                << ", \"allocations\": " << total.allocations[i] << "}" << (k + 1 < order.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n  \"moves\": " << total.moves << ",\n  \"allocationsPerMove\": " << perMove
+            << ",\n  \"maxAllocationsPerMove\": " << total.maxMoveAllocations
+            << ",\n  \"allocatedBytes\": " << total.allocatedBytes << "\n}\n";
+        return;
+    }
+
+    out << "--- cheta profile ---\n";
+    out << std::left << std::setw(24) << "function" << std::right << std::setw(14) << "calls" << std::setw(14) << "total ms"
+        << std::setw(12) << "ns/call" << std::setw(14) << "allocs" << std::setw(12) << "allocs/call" << "\n";
+    for (int i : order) {
+        out << std::left << std::setw(24) << pointNames[i] << std::right << std::setw(14) << total.calls[i];
+        if (total.nanoseconds[i] != 0 || total.allocations[i] != 0) {
+            out << std::setw(14) << std::fixed << std::setprecision(3) << total.nanoseconds[i] / 1e6
+                << std::setw(12) << total.nanoseconds[i] / total.calls[i]
+                << std::setw(14) << total.allocations[i]
+                << std::setw(12) << std::setprecision(2) << static_cast<double>(total.allocations[i]) / total.calls[i];
+        }
+        out << "\n";
+    }
+    out << "moves: " << total.moves << ", allocations per move: " << std::fixed << std::setprecision(1) << perMove
+        << " (max " << total.maxMoveAllocations << "), allocated bytes: " << total.allocatedBytes << "\n";
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+//    Board  Game.      
+// :    .   CHETA_INSTRUMENT
+// (g++ -DCHETA_INSTRUMENT,  Visual Studio -  " ").
+//
+//              .
+//     (isValidMove  hasRequiredJumps  ..).
+//    operator new:     
+//      .
+//
+//      :  stderr      
+// CHETA_PROFILE (    .json -   JSON).
+
+#include <cstdint>
+#include <iosfwd>
+
+enum class ProfilePoint {
+    //   :   ,   
+    GET_PIECE,
+    GET_PIECE_COLOR,
+    IS_INSIDE_BOARD,
+    // ,    
+    INITIALIZE,
+    IS_VALID_MOVE,
+    IS_JUMP_POSSIBLE,
+    IS_REGULAR_MOVE_POSSIBLE,
+    CAN_JUMP_FROM,
+    GET_POSSIBLE_MOVES,
+    GET_REQUIRED_JUMPS,
+    HAS_REQUIRED_JUMPS,
+    MAKE_MOVE,
+    SET_PIECE,
+    CLEAR_PIECE,
+    REMOVE_PIECE,
+    APPLY_STEP,
+    CHECK_GAME_END,
+    COUNT
+};
+
+#ifdef CHETA_INSTRUMENT
+
+#include <chrono>
+
+class Profiler {
+public:
+    static void count(ProfilePoint point);
+    static void record(ProfilePoint point, int64_t nanoseconds, uint64_t allocations);
+    static void endMove();              //  :       
+    static uint64_t allocations();      //        
+
+    static void writeReport(std::ostream& out, bool json);
+    static void reset();                //    
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePoint point) :
+        point(point), startAllocations(Profiler::allocations()), started(std::chrono::steady_clock::now()) {}
+    ~ProfileScope() {
+        auto elapsed = std::chrono::steady_clock::now() - started;
+        Profiler::record(point, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+            Profiler::allocations() - startAllocations);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfilePoint point;
+    uint64_t startAllocations;
+    std::chrono::steady_clock::time_point started;
+};
+
+#define CHETA_PROFILE_SCOPE(point) ProfileScope profileScope(ProfilePoint::point)
+#define CHETA_PROFILE_COUNT(point) Profiler::count(ProfilePoint::point)
+#define CHETA_PROFILE_MOVE() Profiler::endMove()
+
+#else
+
+#define CHETA_PROFILE_SCOPE(point) ((void)0)
+#define CHETA_PROFILE_COUNT(point) ((void)0)
+#define CHETA_PROFILE_MOVE() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+#include "Renderer.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+TerminalRenderer::TerminalRenderer() : hasPrevious(false) {
+#ifdef _WIN32
+    //  Windows  ANSI     
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(console, &mode)) {
+        SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+    frame.reserve(4096);
+}
+
+void TerminalRenderer::invalidate() {
+    hasPrevious = false;
+}
+
+void TerminalRenderer::moveTo(int line, int column) {
+    char text[16];
+    int length = std::snprintf(text, sizeof(text), "\x1b[%d;%dH", line, column);
+    frame.append(text, static_cast<size_t>(length));
+}
+
+void TerminalRenderer::writeCell(int row, int col, const Cell& cell) {
+    moveTo(2 + row, 3 + 2 * col);
+    if (cell.style == 1) frame += "\x1b[30;43m";      //   -  
+    else if (cell.style == 2) frame += "\x1b[30;42m"; //    -  
+    frame += cell.symbol;
+    if (cell.style != 0) frame += "\x1b[0m";
+}
+
+void TerminalRenderer::render(const Board& board, const BoardHighlights& highlights,
+    const std::string& status, const std::string& message)
+{
+    frame.clear();
+    if (!hasPrevious) {
+        //  :       
+        frame += "\x1b[0m\x1b[2J\x1b[H  ";
+        for (int j = 0; j < size; ++j) {
+            frame += static_cast<char>('0' + j);
+            frame += ' ';
+        }
+        for (int i = 0; i < size; ++i) {
+            moveTo(2 + i, 1);
+            frame += static_cast<char>('0' + i);
+            moveTo(2 + i, 3 + 2 * size);
+            frame += static_cast<char>('0' + i);
+        }
+        moveTo(2 + size, 1);
+        frame += "  ";
+        for (int j = 0; j < size; ++j) {
+            frame += static_cast<char>('0' + j);
+            frame += ' ';
+        }
+    }
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            Cell cell;
+            Piece* piece = board.getPiece(i, j);
+            if (piece) {
+                bool white = piece->getColor() == PieceColor::WHITE;
+                cell.symbol = piece->isKing() ? (white ? 'W' : 'B') : (white ? 'w' : 'b');
+            }
+            else {
+                cell.symbol = ((i + j) % 2 == 0) ? '.' : '-';
+            }
+            uint64_t bit = 1ull << (i * 8 + j);
+            cell.style = (highlights.lastMove & bit) ? 1 : ((highlights.destinations & bit) ? 2 : 0);
+
+            if (!hasPrevious || cell != previous[i][j]) {
+                writeCell(i, j, cell);
+                previous[i][j] = cell;
+            }
+        }
+    }
+
+    if (!hasPrevious || status != previousStatus) {
+        moveTo(statusLine, 1);
+        frame += "\x1b[2K";
+        frame += status;
+        previousStatus = status;
+    }
+    if (!hasPrevious || message != previousMessage) {
+        moveTo(statusLine + 1, 1);
+        frame += "\x1b[2K";
+        frame += message;
+        previousMessage = message;
+    }
+    //      ,  -   
+    moveTo(promptLine, 1);
+    frame += "\x1b[J";
+    hasPrevious = true;
+    writeFrame();
+}
+
+void TerminalRenderer::writeFrame() {
+    std::fflush(stdout); // ,     std::cout,    
+#ifdef _WIN32
+    std::fwrite(frame.data(), 1, frame.size(), stdout);
+    std::fflush(stdout);
+#else
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t result = ::write(STDOUT_FILENO, frame.data() + written, frame.size() - written);
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+    }
+#endif
+}
@@ -0,0 +1,51 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include "Board.h"
+#include <cstdint>
+#include <string>
+
+//    .    row * 8 + col.
+struct BoardHighlights {
+    uint64_t lastMove = 0;      //      
+    uint64_t destinations = 0;  //    
+};
+
+//      escape- ANSI  system("cls")
+//   .     :   
+//         ,   write.
+//  -   ,    ,   .
+//
+// :  1 -  , 2..9 - , 10 -  ,
+// 11..12 -  ,  13- -    (  ).
+class TerminalRenderer {
+public:
+    TerminalRenderer();
+
+    void render(const Board& board, const BoardHighlights& highlights,
+        const std::string& status, const std::string& message);
+    void invalidate(); //     (   )
+
+private:
+    struct Cell {
+        char symbol = 0;
+        uint8_t style = 0; // 0 - , 1 -  , 2 -  
+        bool operator!=(const Cell& other) const { return symbol != other.symbol || style != other.style; }
+    };
+
+    static const int size = 8;
+    static const int statusLine = 11;
+    static const int promptLine = 13;
+
+    Cell previous[size][size];
+    std::string previousStatus;
+    std::string previousMessage;
+    bool hasPrevious;
+    std::string frame; //   ,    
+
+    void moveTo(int line, int column);
+    void writeCell(int row, int col, const Cell& cell);
+    void writeFrame();
+};
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <cstdint>
+
+//  ,       ,  
+enum class CapturePromotion {
+    ENDS_MOVE,          // ,     
+    CONTINUES_AS_KING,  //       
+    ONLY_AT_END         // ,       
+};
+
+//   -     . VariantMoveGen<Rules> 
+//   if constexpr,         
+//    . Mask -       .
+//
+// removeCapturedImmediately:     (    
+//     )     ( ,     ).
+
+//    (Board, Game  MoveGen):   ,  , 
+//  ,     .
+struct HouseRules {
+    using Mask = uint32_t;
+    static constexpr const char* name = "house";
+    static constexpr int boardSize = 8;
+    static constexpr int rowsPerSide = 3;
+    static constexpr bool menCaptureBackward = true;
+    static constexpr bool flyingKings = true;
+    static constexpr bool maximumCapture = false;
+    static constexpr bool removeCapturedImmediately = true;
+    static constexpr CapturePromotion promotion = CapturePromotion::ENDS_MOVE;
+};
+
+//  :   ,      ,  
+//        
+struct RussianRules {
+    using Mask = uint32_t;
+    static constexpr const char* name = "russian";
+    static constexpr int boardSize = 8;
+    static constexpr int rowsPerSide = 3;
+    static constexpr bool menCaptureBackward = true;
+    static constexpr bool flyingKings = true;
+    static constexpr bool maximumCapture = false;
+    static constexpr bool removeCapturedImmediately = false;
+    static constexpr CapturePromotion promotion = CapturePromotion::CONTINUES_AS_KING;
+};
+
+//  () :    ,     
+struct EnglishRules {
+    using Mask = uint32_t;
+    static constexpr const char* name = "english";
+    static constexpr int boardSize = 8;
+    static constexpr int rowsPerSide = 3;
+    static constexpr bool menCaptureBackward = false;
+    static constexpr bool flyingKings = false;
+    static constexpr bool maximumCapture = false;
+    static constexpr bool removeCapturedImmediately = false;
+    static constexpr CapturePromotion promotion = CapturePromotion::ENDS_MOVE;
+};
+
+//  :     8x8
+struct BrazilianRules {
+    using Mask = uint32_t;
+    static constexpr const char* name = "brazilian";
+    static constexpr int boardSize = 8;
+    static constexpr int rowsPerSide = 3;
+    static constexpr bool menCaptureBackward = true;
+    static constexpr bool flyingKings = true;
+    static constexpr bool maximumCapture = true;
+    static constexpr bool removeCapturedImmediately = false;
+    static constexpr CapturePromotion promotion = CapturePromotion::ONLY_AT_END;
+};
+
+//   10x10:     
+struct InternationalRules {
+    using Mask = uint64_t;
+    static constexpr const char* name = "international";
+    static constexpr int boardSize = 10;
+    static constexpr int rowsPerSide = 4;
+    static constexpr bool menCaptureBackward = true;
+    static constexpr bool flyingKings = true;
+    static constexpr bool maximumCapture = true;
+    static constexpr bool removeCapturedImmediately = false;
+    static constexpr CapturePromotion promotion = CapturePromotion::ONLY_AT_END;
+};
+
+//   size x size:     , sq = row * size/2 + col/2
+// ( 8x8   Position).    MoveGen: 0/1 - , 2/3 - .
+template <int size>
+struct BoardGeometry {
+    static constexpr int half = size / 2;
+    static constexpr int squares = size * half;
+
+    static constexpr int rowOf(int sq) { return sq / half; }
+    static constexpr int colOf(int sq) { return (sq / half) % 2 == 0 ? (sq % half) * 2 + 1 : (sq % half) * 2; }
+    static constexpr int square(int row, int col) { return ((row + col) % 2 == 1) ? row * half + col / 2 : -1; }
+
+    struct Table {
+        int8_t next[squares][4] = {};
+    };
+
+    static constexpr Table makeTable() {
+        Table table;
+        const int rowStep[4] = { 1, 1, -1, -1 };
+        const int colStep[4] = { -1, 1, -1, 1 };
+        for (int sq = 0; sq < squares; ++sq) {
+            for (int dir = 0; dir < 4; ++dir) {
+                int row = rowOf(sq) + rowStep[dir];
+                int col = colOf(sq) + colStep[dir];
+                table.next[sq][dir] = (row >= 0 && row < size && col >= 0 && col < size) ? static_cast<int8_t>(square(row, col)) : -1;
+            }
+        }
+        return table;
+    }
+
+    static constexpr Table table = makeTable();
+};
+
+#endif
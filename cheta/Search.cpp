@@ -0,0 +1,284 @@
+#include "Search.h"
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+const int maxPly = 120;
+const int mateBound = Search::winScore - 1000; //   -  
+
+int64_t elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+//      ,      
+int toTable(int score, int ply) {
+    if (score > mateBound) return score + ply;
+    if (score < -mateBound) return score - ply;
+    return score;
+}
+
+int fromTable(int score, int ply) {
+    if (score > mateBound) return score - ply;
+    if (score < -mateBound) return score + ply;
+    return score;
+}
+
+} // namespace
+
+Search::Search(int ttBits) :
+    table(static_cast<size_t>(1) << ttBits), tableMask((static_cast<uint64_t>(1) << ttBits) - 1),
+    stopRequested(false), aborted(false), nodes(0), hasDeadline(false), historyLength(0) {}
+
+void Search::clear() {
+    std::fill(table.begin(), table.end(), TTEntry());
+}
+
+int Search::evaluate(const Position& position) {
+    //       
+    int score = 0;
+    for (uint32_t pieces = position.white; pieces; pieces &= pieces - 1) {
+        int sq = 0;
+        while (!((pieces >> sq) & 1u)) ++sq;
+        score += (position.kings & (1u << sq)) ? 300 : 100 + 4 * Position::rowOf(sq);
+    }
+    for (uint32_t pieces = position.black; pieces; pieces &= pieces - 1) {
+        int sq = 0;
+        while (!((pieces >> sq) & 1u)) ++sq;
+        score -= (position.kings & (1u << sq)) ? 300 : 100 + 4 * (7 - Position::rowOf(sq));
+    }
+    return position.sideToMove == PieceColor::WHITE ? score : -score;
+}
+
+bool Search::timeUp() {
+    return hasDeadline && std::chrono::steady_clock::now() >= deadline;
+}
+
+int Search::alphaBeta(const Position& position, int depth, int alpha, int beta, int ply) {
+    ++nodes;
+    if ((nodes & 2047) == 0 && (timeUp() || stopRequested)) {
+        aborted = true;
+    }
+    if (aborted) {
+        return 0;
+    }
+
+    uint64_t key = position.hash();
+    for (int i = historyLength - 2; i >= 0; i -= 2) {
+        if (history[i] == key) return 0; //   - 
+    }
+    if (ply >= maxPly) {
+        return evaluate(position);
+    }
+
+    MoveList list;
+    MoveGen::generate(position, list);
+    if (list.count == 0) {
+        return -(winScore - ply); //   - 
+    }
+    //       ( ,    )
+    if (depth <= 0 && !list.moves[0].isCapture()) {
+        return evaluate(position);
+    }
+
+    TTEntry& entry = table[key & tableMask];
+    int bestIndex = -1;
+    if (entry.key == key) {
+        if (depth > 0 && entry.depth >= depth) {
+            int stored = fromTable(entry.score, ply);
+            if (entry.flag == 0) return stored;
+            if (entry.flag == 1 && stored >= beta) return stored;
+            if (entry.flag == 2 && stored <= alpha) return stored;
+        }
+        if (entry.bestIndex < list.count) bestIndex = entry.bestIndex;
+    }
+
+    int originalAlpha = alpha;
+    int bestScore = -winScore;
+    int bestMove = 0;
+    history[historyLength++] = key;
+    for (int n = -1; n < list.count; ++n) {
+        //     ,    
+        int i = n < 0 ? bestIndex : n;
+        if (i < 0 || (n >= 0 && n == bestIndex)) continue;
+        Position child = MoveGen::apply(position, list.moves[i]);
+        int score = -alphaBeta(child, depth - 1, -beta, -alpha, ply + 1);
+        if (aborted) {
+            --historyLength;
+            return 0;
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = i;
+        }
+        if (score > alpha) alpha = score;
+        if (alpha >= beta) break;
+    }
+    --historyLength;
+
+    if (depth > 0) {
+        entry.key = key;
+        entry.score = static_cast<int16_t>(toTable(bestScore, ply));
+        entry.depth = static_cast<int8_t>(std::min(depth, 127));
+        entry.flag = bestScore <= originalAlpha ? 2 : (bestScore >= beta ? 1 : 0);
+        entry.bestIndex = static_cast<uint8_t>(bestMove);
+    }
+    return bestScore;
+}
+
+std::vector<Move> Search::principalVariation(const Position& position, int maxLength) const {
+    std::vector<Move> pv;
+    Position current = position;
+    std::vector<uint64_t> seen;
+    while (static_cast<int>(pv.size()) < maxLength) {
+        uint64_t key = current.hash();
+        const TTEntry& entry = table[key & tableMask];
+        if (entry.key != key || std::find(seen.begin(), seen.end(), key) != seen.end()) break;
+        MoveList list;
+        MoveGen::generate(current, list);
+        if (entry.bestIndex >= list.count) break;
+        seen.push_back(key);
+        pv.push_back(list.moves[entry.bestIndex]);
+        current = MoveGen::apply(current, list.moves[entry.bestIndex]);
+    }
+    return pv;
+}
+
+void Search::startClock(const SearchLimits& limits) {
+    aborted = stopRequested;
+    nodes = 0;
+    historyLength = 0;
+    hasDeadline = limits.moveTimeMs > 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.moveTimeMs);
+}
+
+std::vector<RootMoveInfo> Search::analyse(const Position& position, const SearchLimits& limits, int multiPV, int& depth) {
+    startClock(limits);
+    depth = 0;
+
+    MoveList root;
+    MoveGen::generate(position, root);
+    std::vector<RootMoveInfo> result;
+    if (root.count == 0 || multiPV < 1) {
+        return result;
+    }
+
+    std::vector<RootMoveInfo> current(static_cast<size_t>(root.count));
+    for (int i = 0; i < root.count; ++i) {
+        current[i].move = root.moves[i];
+    }
+
+    for (int iteration = 1; iteration <= limits.depth && iteration < maxPly; ++iteration) {
+        //     ;    K-  ,
+        //      ,    multiPV
+        std::vector<RootMoveInfo> next = current;
+        std::vector<int> best; //     
+        history[historyLength++] = position.hash();
+        for (RootMoveInfo& info : next) {
+            int alpha = static_cast<int>(best.size()) < multiPV ? -winScore - 1 : best[multiPV - 1];
+            Position child = MoveGen::apply(position, info.move);
+            int score = -alphaBeta(child, iteration - 1, -winScore - 1, -alpha, 1);
+            if (aborted) break;
+            info.score = score;
+            info.pv.clear();
+            if (score > alpha) {
+                best.insert(std::upper_bound(best.begin(), best.end(), score, std::greater<int>()), score);
+                info.pv.push_back(info.move);
+                std::vector<Move> rest = principalVariation(child, iteration - 1);
+                info.pv.insert(info.pv.end(), rest.begin(), rest.end());
+            }
+            else {
+                info.score = alpha - 1; //   :   multiPV  
+            }
+        }
+        historyLength = 0;
+        if (aborted) {
+            break; //    
+        }
+        std::stable_sort(next.begin(), next.end(),
+            [](const RootMoveInfo& a, const RootMoveInfo& b) { return a.score > b.score; });
+        current = next;
+        depth = iteration;
+        if (root.count == 1 || current[0].score > mateBound) {
+            break;
+        }
+    }
+
+    if (depth == 0) {
+        return result; //      
+    }
+    for (int i = 0; i < multiPV && i < root.count; ++i) {
+        result.push_back(current[i]);
+    }
+    return result;
+}
+
+bool Search::think(const Position& position, const SearchLimits& limits,
+    const std::function<void(const SearchInfo&)>& onInfo, Move& best)
+{
+    auto start = std::chrono::steady_clock::now();
+    startClock(limits);
+
+    MoveList root;
+    MoveGen::generate(position, root);
+    if (root.count == 0) {
+        return false;
+    }
+    best = root.moves[0];
+    if (root.count == 1) {
+        //   -    
+        SearchInfo info;
+        info.depth = 1;
+        info.score = -evaluate(MoveGen::apply(position, best));
+        info.pv.push_back(best);
+        if (onInfo) onInfo(info);
+        return true;
+    }
+
+    int bestIndex = 0;
+    for (int depth = 1; depth <= limits.depth && depth < maxPly; ++depth) {
+        int alpha = -winScore - 1;
+        int iterationBest = bestIndex;
+        history[historyLength++] = position.hash();
+        for (int n = -1; n < root.count; ++n) {
+            int i = n < 0 ? bestIndex : n; //     
+            if (n >= 0 && i == bestIndex) continue;
+            int score = -alphaBeta(MoveGen::apply(position, root.moves[i]), depth - 1, -winScore - 1, -alpha, 1);
+            if (aborted) break;
+            if (score > alpha) {
+                alpha = score;
+                iterationBest = i;
+            }
+        }
+        historyLength = 0;
+        if (aborted) {
+            break; //    
+        }
+        bestIndex = iterationBest;
+        best = root.moves[bestIndex];
+
+        //   ,       
+        TTEntry& entry = table[position.hash() & tableMask];
+        entry.key = position.hash();
+        entry.score = static_cast<int16_t>(toTable(alpha, 0));
+        entry.depth = static_cast<int8_t>(depth);
+        entry.flag = 0;
+        entry.bestIndex = static_cast<uint8_t>(bestIndex);
+
+        SearchInfo info;
+        info.depth = depth;
+        info.score = alpha;
+        info.nodes = nodes;
+        info.timeMs = elapsedMs(start);
+        //  :    
+        int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        info.nps = micros > 0 ? nodes * 1000000 / static_cast<uint64_t>(micros) : 0;
+        info.pv = principalVariation(position, depth);
+        if (onInfo) onInfo(info);
+
+        if (alpha > mateBound || alpha < -mateBound) {
+            break; //     
+        }
+    }
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "MoveGen.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct SearchLimits {
+    int depth = 64;       //    
+    int moveTimeMs = 0;   // 0 -   
+};
+
+//     
+struct SearchInfo {
+    int depth = 0;
+    int score = 0;        //    ,  
+    uint64_t nodes = 0;
+    int64_t timeMs = 0;
+    uint64_t nps = 0;
+    std::vector<Move> pv;
+};
+
+//      (    )
+struct RootMoveInfo {
+    Move move;
+    int score = 0;
+    std::vector<Move> pv;
+};
+
+//  -      .
+//   -  ; stop()     .  
+// think()  ,  stop()     :    resetStop().
+class Search {
+public:
+    static const int winScore = 30000; //   n    winScore - n
+
+    explicit Search(int ttBits = 20);
+
+    //   . onInfo     .
+    //   ,  false.
+    bool think(const Position& position, const SearchLimits& limits,
+        const std::function<void(const SearchInfo&)>& onInfo, Move& best);
+
+    // :  multiPV      ,   .
+    // depth -    .
+    std::vector<RootMoveInfo> analyse(const Position& position, const SearchLimits& limits, int multiPV, int& depth);
+
+    uint64_t getNodes() const { return nodes; }
+
+    void stop() { stopRequested = true; }
+    void resetStop() { stopRequested = false; }
+    void clear(); //    ( )
+
+    static int evaluate(const Position& position);
+
+private:
+    struct TTEntry {
+        uint64_t key = 0;
+        int16_t score = 0;
+        int8_t depth = -1;
+        uint8_t flag = 0;      // 0 - , 1 -  , 2 - 
+        uint8_t bestIndex = 255;
+    };
+
+    std::vector<TTEntry> table;
+    uint64_t tableMask;
+    std::atomic<bool> stopRequested;
+    bool aborted;          //  : stop()   
+    uint64_t nodes;
+    std::chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    uint64_t history[128]; //        
+    int historyLength;
+
+    int alphaBeta(const Position& position, int depth, int alpha, int beta, int ply);
+    bool timeUp();
+    void startClock(const SearchLimits& limits);
+    std::vector<Move> principalVariation(const Position& position, int maxLength) const;
+};
+
+#endif
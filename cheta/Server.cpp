@@ -0,0 +1,1027 @@
+#include "Server.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+//     epoll_event.data.u64.    firstConnectionId.
+const uint64_t listenTag = 1;
+const uint64_t wakeTag = 2;
+const uint64_t stopTag = 3;
+const uint64_t firstConnectionId = 16;
+
+//        : ,   
+//  '\n'    , ,     
+const size_t maxLineLength = 4096;
+const size_t maxPendingOutput = 1 << 20;
+//     epoll (   ,     ),
+//       epoll      
+const size_t maxReadPerEvent = 1 << 16;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+char stateChar(GameState state) {
+    switch (state) {
+    case GameState::WHITE_WON: return 'W';
+    case GameState::BLACK_WON: return 'B';
+    case GameState::DRAW: return 'D';
+    default: return 'P';
+    }
+}
+
+//      (row * 4 + col / 2): . - , w/b - , W/B - 
+std::string boardString(const Board& board) {
+    std::string text;
+    text.reserve(32);
+    for (int row = 0; row < board.getBoardSize(); ++row) {
+        for (int col = (row % 2 == 0) ? 1 : 0; col < board.getBoardSize(); col += 2) {
+            Piece* piece = board.getPiece(row, col);
+            if (!piece) {
+                text += '.';
+            }
+            else if (piece->getColor() == PieceColor::WHITE) {
+                text += piece->isKing() ? 'W' : 'w';
+            }
+            else {
+                text += piece->isKing() ? 'B' : 'b';
+            }
+        }
+    }
+    return text;
+}
+
+//   W:    (        ,   boardString)
+std::string snapshotString(const GameSnapshot& snapshot) {
+    Position position = Notation::unpack(snapshot.position);
+    std::string text = std::to_string(snapshot.ply) + " " + stateChar(snapshot.state) + " " +
+        (position.sideToMove == PieceColor::WHITE ? "W " : "B ");
+    for (int sq = 0; sq < 32; ++sq) {
+        uint32_t mask = 1u << sq;
+        bool king = (position.kings & mask) != 0;
+        text += (position.white & mask) ? (king ? 'W' : 'w') : (position.black & mask) ? (king ? 'B' : 'b') : '.';
+    }
+    if (snapshot.lastFrom < 0) {
+        return text + " -";
+    }
+    return text + " " + std::to_string(snapshot.lastFrom + 1) + (snapshot.lastCapture ? "x" : "-") + std::to_string(snapshot.lastTo + 1);
+}
+
+//      (      )
+bool pickRandomStep(const Game& game, std::mt19937& rng, int& fromRow, int& fromCol, int& toRow, int& toCol) {
+    const Board& board = game.getBoard();
+    PieceColor color = game.getCurrentPlayerColor();
+    std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> steps;
+
+    auto jumping = game.getJumpingPiece();
+    for (int row = 0; row < board.getBoardSize(); ++row) {
+        for (int col = 0; col < board.getBoardSize(); ++col) {
+            if (jumping && (jumping->first != row || jumping->second != col)) {
+                continue;
+            }
+            if (board.getPieceColor(row, col) != color) {
+                continue;
+            }
+            for (const auto& to : board.getPossibleMoves(row, col, color)) {
+                if (jumping && !board.isJumpPossible(row, col, to.first, to.second, color)) {
+                    continue; //     
+                }
+                steps.push_back({ {row, col}, to });
+            }
+        }
+    }
+    if (steps.empty()) {
+        return false;
+    }
+    const auto& step = steps[std::uniform_int_distribution<size_t>(0, steps.size() - 1)(rng)];
+    fromRow = step.first.first;
+    fromCol = step.first.second;
+    toRow = step.second.first;
+    toCol = step.second.second;
+    return true;
+}
+
+} // namespace
+
+GameServer::GameServer(const ServerConfig& config) :
+    config(config), listenFd(-1), epollFd(-1), wakeFd(-1), stopFd(-1), running(false),
+    nextGameId(1), nextConnectionId(firstConnectionId), nextExpiryNs(0), journalFailed(false)
+{
+    if (this->config.workers < 1) {
+        this->config.workers = 1;
+    }
+}
+
+GameServer::~GameServer()
+{
+    for (auto& worker : workers) {
+        {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->stopping = true;
+        }
+        worker->wakeup.notify_one();
+        worker->thread.join();
+    }
+    for (auto& entry : connections) {
+        ::close(entry.second->fd);
+    }
+    for (int fd : { listenFd, epollFd, wakeFd, stopFd }) {
+        if (fd != -1) {
+            ::close(fd);
+        }
+    }
+    if (!config.unixPath.empty()) {
+        ::unlink(config.unixPath.c_str());
+    }
+}
+
+bool GameServer::open()
+{
+    if (!config.unixPath.empty()) {
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (config.unixPath.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Socket path is too long: " << config.unixPath << std::endl;
+            return false;
+        }
+        std::strcpy(address.sun_path, config.unixPath.c_str());
+        ::unlink(config.unixPath.c_str());
+        if (listenFd == -1 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+            std::cerr << "Cannot bind " << config.unixPath << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    else {
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int yes = 1;
+        ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(config.tcpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (listenFd == -1 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+            std::cerr << "Cannot bind 127.0.0.1:" << config.tcpPort << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    if (::listen(listenFd, SOMAXCONN) == -1) {
+        std::cerr << "listen failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd == -1 || wakeFd == -1 || stopFd == -1) {
+        std::cerr << "epoll/eventfd failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    for (auto entry : { std::make_pair(listenFd, listenTag), std::make_pair(wakeFd, wakeTag), std::make_pair(stopFd, stopTag) }) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = entry.second;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, entry.first, &event);
+    }
+
+    for (int i = 0; i < config.workers; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    if (!config.eventsPath.empty()) {
+        //      ,    -   
+        eventLog = std::make_unique<EventLog>();
+        if (!eventLog->open(config.eventsPath)) {
+            return false;
+        }
+        for (auto& worker : workers) {
+            worker->events = eventLog->attach();
+        }
+    }
+    if (!config.journalPath.empty()) {
+        //            ,  dispatch
+        std::unordered_map<uint32_t, std::unique_ptr<Game>> recovered;
+        JournalRecovery report;
+        if (!recoverGames(config.journalPath, recovered, report)) {
+            return false;
+        }
+        uint64_t deadline = nowNs() + static_cast<uint64_t>(config.claimTimeoutSeconds) * 1000000000ull;
+        for (auto& entry : recovered) {
+            snapshots[entry.first] = entry.second->getSnapshots();
+            unclaimed[entry.first] = deadline;
+            nextGameId = std::max(nextGameId, entry.first + 1);
+            Worker& worker = *workers[entry.first % workers.size()];
+            if (worker.events) {
+                entry.second->setEventLog(worker.events, entry.first);
+            }
+            worker.games[entry.first] = std::move(entry.second);
+        }
+        std::cout << "Recovered " << recovered.size() << " games (" << report.turns << " turns, "
+            << report.rejected << " rejected) in " << report.seconds * 1000 << " ms" << std::endl;
+        journal = std::make_unique<MoveJournal>(config.journalPath);
+        if (!journal->open()) {
+            return false;
+        }
+    }
+    for (auto& worker : workers) {
+        Worker* raw = worker.get();
+        worker->thread = std::thread([this, raw]() { workerLoop(*raw); });
+    }
+    return true;
+}
+
+void GameServer::stop()
+{
+    uint64_t one = 1;
+    ssize_t ignored = ::write(stopFd, &one, sizeof(one)); // write    
+    (void)ignored;
+}
+
+void GameServer::run()
+{
+    running = true;
+    epoll_event events[256];
+    while (running) {
+        //     ,       
+        int count = ::epoll_wait(epollFd, events, 256, unclaimed.empty() ? -1 : 1000);
+        if (count == -1) {
+            if (errno == EINTR) continue;
+            std::cerr << "epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            uint64_t tag = events[i].data.u64;
+            if (tag == listenTag) {
+                acceptConnections();
+            }
+            else if (tag == wakeTag) {
+                uint64_t value;
+                while (::read(wakeFd, &value, sizeof(value)) > 0) {}
+                deliverResponses();
+            }
+            else if (tag == stopTag) {
+                running = false;
+            }
+            else {
+                auto it = connections.find(tag);
+                if (it == connections.end()) continue;
+                Connection& connection = *it->second;
+                if (events[i].events & EPOLLOUT) {
+                    flushConnection(tag, connection);
+                    if (connections.count(tag) == 0) continue; // :    
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+                    readConnection(tag, connection); //     EOF/
+                }
+            }
+        }
+        if (!unclaimed.empty()) {
+            expireUnclaimed();
+        }
+    }
+}
+
+void GameServer::expireUnclaimed()
+{
+    uint64_t now = nowNs();
+    if (now < nextExpiryNs) return;
+    nextExpiryNs = now + 1000000000ull;
+    for (auto it = unclaimed.begin(); it != unclaimed.end();) {
+        if (it->second > now) {
+            ++it;
+            continue;
+        }
+        //  X,   :         
+        dispatch(Job{ JobType::DROP, 0, it->first, 0, 0, 0, 0, now, nullptr });
+        snapshots.erase(it->first);
+        it = unclaimed.erase(it);
+    }
+}
+
+void GameServer::acceptConnections()
+{
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd == -1) {
+            return; // EAGAIN:    
+        }
+        if (config.unixPath.empty()) {
+            int yes = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        }
+        uint64_t id = nextConnectionId++;
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = id;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        connections[id] = std::move(connection);
+    }
+}
+
+void GameServer::readConnection(uint64_t id, Connection& connection)
+{
+    char buffer[16384];
+    bool closed = false;
+    size_t total = 0;
+    while (true) {
+        ssize_t received = ::read(connection.fd, buffer, sizeof(buffer));
+        if (received > 0) {
+            total += static_cast<size_t>(received);
+            connection.input.append(buffer, static_cast<size_t>(received));
+            //     :      
+            size_t start = 0;
+            while (true) {
+                size_t end = connection.input.find('\n', start);
+                if (end == std::string::npos) break;
+                std::string line = connection.input.substr(start, end - start);
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                handleLine(id, connection, line);
+                start = end + 1;
+            }
+            connection.input.erase(0, start);
+            if (connection.input.size() > maxLineLength) {
+                closed = true;
+                break;
+            }
+            //    -   : flushConnection      
+            if (connection.output.size() > maxPendingOutput || total >= maxReadPerEvent) break;
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EINTR)) {
+            closed = true;
+        }
+        if (received == -1 && errno == EINTR) continue;
+        break;
+    }
+
+    if (closed) {
+        closeConnection(id);
+    }
+    else if (!connection.output.empty()) {
+        flushConnection(id, connection); // ,     epoll
+    }
+}
+
+void GameServer::handleLine(uint64_t id, Connection& connection, const std::string& line)
+{
+    if (line.empty()) return;
+
+    Job job{ JobType::NEW, id, 0, 0, 0, 0, 0, nowNs(), nullptr };
+    char command = line[0];
+    unsigned long gameId = 0;
+    char digits[8] = {};
+    int fields = std::sscanf(line.c_str() + 1, " %lu %7s", &gameId, digits);
+    job.gameId = static_cast<uint32_t>(gameId);
+
+    if (journalFailed && (command == 'N' || command == 'M')) {
+        connection.output += "E " + std::to_string(gameId) + " journal failure\n";
+        return;
+    }
+
+    switch (command) {
+    case 'N':
+        job.type = JobType::NEW;
+        job.gameId = nextGameId++;
+        job.snapshots = std::make_shared<SnapshotSlot>();
+        snapshots[job.gameId] = job.snapshots;
+        connection.games.insert(job.gameId);
+        dispatch(job);
+        return;
+    case 'W': {
+        // :    ,     
+        auto it = snapshots.find(job.gameId);
+        GameSnapshot snapshot;
+        if (fields < 1 || it == snapshots.end()) {
+            connection.output += "E " + std::to_string(gameId) + " unknown game\n";
+        }
+        else if (!it->second->read(snapshot)) {
+            connection.output += "E " + std::to_string(gameId) + " game not started\n";
+        }
+        else {
+            connection.output += "V " + std::to_string(gameId) + " " + snapshotString(snapshot) + "\n";
+        }
+        return;
+    }
+    case 'S':
+        connection.output += "L " + latencyReport() + "\n";
+        return;
+    case 'J': {
+        //    :     
+        auto it = unclaimed.find(job.gameId);
+        if (fields < 1 || it == unclaimed.end()) {
+            connection.output += "E " + std::to_string(gameId) + " unknown game\n";
+        }
+        else {
+            unclaimed.erase(it);
+            connection.games.insert(job.gameId);
+            connection.output += "G " + std::to_string(gameId) + "\n";
+        }
+        return;
+    }
+    case 'M':
+    case 'B':
+    case 'X':
+        break;
+    default:
+        connection.output += "E 0 unknown command\n";
+        return;
+    }
+
+    if (fields < 1 || connection.games.count(job.gameId) == 0) {
+        connection.output += "E " + std::to_string(gameId) + " unknown game\n";
+        return;
+    }
+    if (command == 'B') {
+        job.type = JobType::BOARD;
+    }
+    else if (command == 'X') {
+        job.type = JobType::DROP;
+        connection.games.erase(job.gameId);
+        snapshots.erase(job.gameId);
+    }
+    else {
+        if (fields < 2 || std::strlen(digits) != 4 || !std::all_of(digits, digits + 4, [](char c) { return c >= '0' && c <= '9'; })) {
+            connection.output += "E " + std::to_string(gameId) + " malformed move\n";
+            return;
+        }
+        job.type = JobType::MOVE;
+        job.fromRow = digits[0] - '0';
+        job.fromCol = digits[1] - '0';
+        job.toRow = digits[2] - '0';
+        job.toCol = digits[3] - '0';
+    }
+    dispatch(job);
+}
+
+void GameServer::dispatch(const Job& job)
+{
+    Worker& worker = *workers[job.gameId % workers.size()];
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        wasEmpty = worker.jobs.empty();
+        worker.jobs.push_back(job);
+    }
+    if (wasEmpty) {
+        worker.wakeup.notify_one();
+    }
+}
+
+void GameServer::workerLoop(Worker& worker)
+{
+    std::deque<Job> batch;
+    std::vector<Response> out;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+            worker.wakeup.wait(lock, [&worker]() { return !worker.jobs.empty() || worker.stopping; });
+            if (worker.jobs.empty()) {
+                return; //  
+            }
+            batch.swap(worker.jobs);
+        }
+        for (const Job& job : batch) {
+            processJob(worker, job, out);
+        }
+        batch.clear();
+        if (journal && worker.journalTicket != 0) {
+            //     ;     
+            if (!journal->waitDurable(worker.journalTicket)) {
+                journalFailed = true;
+                for (Response& response : out) {
+                    response.line = "E " + std::to_string(response.gameId) + " journal failure\n";
+                }
+            }
+            worker.journalTicket = 0;
+        }
+
+        if (!out.empty()) {
+            //     epoll  
+            {
+                std::lock_guard<std::mutex> lock(responsesMutex);
+                for (auto& response : out) {
+                    responses.push_back(std::move(response));
+                }
+            }
+            out.clear();
+            uint64_t one = 1;
+            ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+}
+
+void GameServer::processJob(Worker& worker, const Job& job, std::vector<Response>& out)
+{
+    std::string id = std::to_string(job.gameId);
+    std::string line;
+
+    if (journalFailed && (job.type == JobType::NEW || job.type == JobType::MOVE)) {
+        line = "E " + id + " journal failure"; //    ,   epoll   
+    }
+    else if (job.type == JobType::NEW) {
+        worker.games[job.gameId] = std::make_unique<Game>(
+            new RemotePlayer("White", PieceColor::WHITE), new RemotePlayer("Black", PieceColor::BLACK), true, job.snapshots);
+        if (worker.events) {
+            worker.games[job.gameId]->setEventLog(worker.events, job.gameId);
+        }
+        if (journal) {
+            worker.journalTicket = journal->logNew(job.gameId);
+        }
+        line = "G " + id;
+    }
+    else {
+        auto it = worker.games.find(job.gameId);
+        if (it == worker.games.end()) {
+            line = "E " + id + " unknown game";
+        }
+        else if (job.type == JobType::DROP) {
+            worker.games.erase(it);
+            if (journal) {
+                worker.journalTicket = journal->logClose(job.gameId);
+            }
+            line = "K " + id;
+        }
+        else if (job.type == JobType::BOARD) {
+            line = "P " + id + " " + boardString(it->second->getBoard());
+        }
+        else {
+            Game& game = *it->second;
+            StepResult step = game.applyStep(job.fromRow, job.fromCol, job.toRow, job.toCol);
+            switch (step.result) {
+            case MoveResult::INVALID:
+                line = "E " + id + " " + step.error;
+                break;
+            case MoveResult::JUMP_CONTINUES:
+                line = "C " + id;
+                break;
+            case MoveResult::TURN_FINISHED:
+                line = "T " + id + " " + stateChar(game.getGameState());
+                if (journal) {
+                    uint64_t ticket = journal->logTurn(job.gameId, game.getLastTurn());
+                    if (ticket == 0) {
+                        journalFailed = true; //   :      
+                        line = "E " + id + " journal failure";
+                    }
+                    else {
+                        worker.journalTicket = ticket;
+                    }
+                }
+                break;
+            }
+            worker.latency.record(nowNs() - job.receivedNs);
+        }
+    }
+
+    if (job.connectionId != 0) {
+        out.push_back(Response{ job.connectionId, job.gameId, line + "\n" });
+    }
+}
+
+void GameServer::deliverResponses()
+{
+    std::vector<Response> ready;
+    {
+        std::lock_guard<std::mutex> lock(responsesMutex);
+        ready.swap(responses);
+    }
+    std::vector<uint64_t> touched;
+    for (Response& response : ready) {
+        auto it = connections.find(response.connectionId);
+        if (it == connections.end()) continue; //   
+        if (it->second->output.empty()) {
+            touched.push_back(response.connectionId);
+        }
+        it->second->output += response.line;
+    }
+    //  write     
+    for (uint64_t id : touched) {
+        auto it = connections.find(id);
+        if (it != connections.end()) {
+            flushConnection(id, *it->second);
+        }
+    }
+}
+
+void GameServer::flushConnection(uint64_t id, Connection& connection)
+{
+    size_t written = 0;
+    while (written < connection.output.size()) {
+        ssize_t sent = ::send(connection.fd, connection.output.data() + written,
+            connection.output.size() - written, MSG_NOSIGNAL);
+        if (sent > 0) {
+            written += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent == -1 && errno == EINTR) continue;
+        break;
+    }
+    connection.output.erase(0, written);
+    if (connection.output.size() > maxPendingOutput) {
+        closeConnection(id);
+        return;
+    }
+
+    //  EPOLLOUT,       
+    bool needWritable = !connection.output.empty();
+    if (needWritable != connection.waitingWritable) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (needWritable ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        event.data.u64 = id;
+        ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.waitingWritable = needWritable;
+    }
+}
+
+void GameServer::closeConnection(uint64_t id)
+{
+    auto it = connections.find(id);
+    if (it == connections.end()) return;
+    //      ;     J  
+    uint64_t deadline = nowNs() + static_cast<uint64_t>(config.claimTimeoutSeconds) * 1000000000ull;
+    for (uint32_t gameId : it->second->games) {
+        if (journal) {
+            unclaimed[gameId] = deadline;
+            continue;
+        }
+        dispatch(Job{ JobType::DROP, 0, gameId, 0, 0, 0, 0, nowNs(), nullptr });
+        snapshots.erase(gameId);
+    }
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    ::close(it->second->fd);
+    connections.erase(it);
+}
+
+std::string GameServer::latencyReport() const
+{
+    LatencyHistogram total;
+    for (const auto& worker : workers) {
+        total.merge(worker->latency);
+    }
+    return total.summary();
+}
+
+std::string GameServer::eventReport() const
+{
+    if (!eventLog) {
+        return "written=0 dropped=0";
+    }
+    return "written=" + std::to_string(eventLog->written()) + " dropped=" + std::to_string(eventLog->dropped());
+}
+
+namespace {
+
+GameServer* activeServer = nullptr;
+
+void handleStopSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+int connectTo(const ServerConfig& config) {
+    int fd;
+    int result;
+    if (!config.unixPath.empty()) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, config.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    else {
+        fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int yes = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(config.tcpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    if (result == -1) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+//      
+class LineReader {
+public:
+    explicit LineReader(int fd) : fd(fd) {}
+
+    bool next(std::string& line) {
+        while (true) {
+            size_t end = buffer.find('\n', start);
+            if (end != std::string::npos) {
+                line.assign(buffer, start, end - start);
+                start = end + 1;
+                return true;
+            }
+            buffer.erase(0, start);
+            start = 0;
+            char chunk[16384];
+            ssize_t received = ::read(fd, chunk, sizeof(chunk));
+            if (received <= 0) return false;
+            buffer.append(chunk, static_cast<size_t>(received));
+        }
+    }
+
+private:
+    int fd;
+    std::string buffer;
+    size_t start = 0;
+};
+
+bool sendAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t sent = ::send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (sent <= 0) return false;
+        written += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+struct ClientTotals {
+    uint64_t steps = 0;
+    uint64_t finishedGames = 0;
+    uint64_t mismatches = 0;
+    uint64_t snapshotReads = 0;
+    bool failed = false;
+};
+
+//    ,   ,   
+void noteGameId(std::atomic<uint32_t>& highestGameId, uint32_t id) {
+    uint32_t seen = highestGameId.load(std::memory_order_relaxed);
+    while (seen < id && !highestGameId.compare_exchange_weak(seen, id, std::memory_order_relaxed)) {}
+}
+
+//    :  games  , 
+//         (,      ).
+//     (   )       .
+void runClientConnection(const ServerConfig& config, int games, int maxPlies, unsigned seed,
+    std::atomic<uint32_t>& highestGameId, ClientTotals& totals) {
+    int fd = connectTo(config);
+    if (fd == -1) {
+        totals.failed = true;
+        return;
+    }
+    LineReader reader(fd);
+    std::mt19937 rng(seed);
+    std::string line;
+
+    std::string request;
+    for (int i = 0; i < games; ++i) request += "N\n";
+    std::unordered_map<uint32_t, std::unique_ptr<Game>> replicas;
+    std::unordered_map<uint32_t, int> plies;
+    if (!sendAll(fd, request)) totals.failed = true;
+    for (int i = 0; i < games && !totals.failed; ++i) {
+        unsigned long id = 0;
+        if (!reader.next(line) || std::sscanf(line.c_str(), "G %lu", &id) != 1) {
+            totals.failed = true;
+            break;
+        }
+        replicas[static_cast<uint32_t>(id)] = std::make_unique<Game>(
+            new RemotePlayer("White", PieceColor::WHITE), new RemotePlayer("Black", PieceColor::BLACK));
+        plies[static_cast<uint32_t>(id)] = 0;
+        noteGameId(highestGameId, static_cast<uint32_t>(id));
+    }
+
+    std::unordered_map<uint32_t, MoveResult> expected;
+    for (int round = 0; !replicas.empty() && !totals.failed; ++round) {
+        if (round % 8 == 7) {
+            auto entry = replicas.begin();
+            GameSnapshot local;
+            entry->second->getSnapshots()->read(local);
+            std::string prefix = "V " + std::to_string(entry->first) + " ";
+            if (!sendAll(fd, "W " + std::to_string(entry->first) + "\n") || !reader.next(line)) {
+                totals.failed = true;
+                break;
+            }
+            if (line != prefix + snapshotString(local)) ++totals.mismatches;
+            ++totals.snapshotReads;
+        }
+        request.clear();
+        expected.clear();
+        std::vector<uint32_t> finished;
+        for (auto& entry : replicas) {
+            Game& game = *entry.second;
+            int fromRow, fromCol, toRow, toCol;
+            if (game.isGameOver() || plies[entry.first] >= maxPlies ||
+                !pickRandomStep(game, rng, fromRow, fromCol, toRow, toCol)) {
+                finished.push_back(entry.first);
+                continue;
+            }
+            StepResult step = game.applyStep(fromRow, fromCol, toRow, toCol);
+            if (step.result == MoveResult::TURN_FINISHED) ++plies[entry.first];
+            expected[entry.first] = step.result;
+            request += "M " + std::to_string(entry.first) + " " + std::to_string(fromRow) +
+                std::to_string(fromCol) + std::to_string(toRow) + std::to_string(toCol) + "\n";
+        }
+        for (uint32_t id : finished) {
+            request += "X " + std::to_string(id) + "\n";
+            replicas.erase(id);
+            ++totals.finishedGames;
+        }
+        if (!sendAll(fd, request)) {
+            totals.failed = true;
+            break;
+        }
+        for (size_t i = 0; i < expected.size() + finished.size(); ++i) {
+            if (!reader.next(line) || line.size() < 3) {
+                totals.failed = true;
+                break;
+            }
+            unsigned long id = std::strtoul(line.c_str() + 2, nullptr, 10);
+            auto it = expected.find(static_cast<uint32_t>(id));
+            if (it == expected.end()) continue; //  K   
+            MoveResult actual = line[0] == 'C' ? MoveResult::JUMP_CONTINUES :
+                line[0] == 'T' ? MoveResult::TURN_FINISHED : MoveResult::INVALID;
+            if (actual != it->second) ++totals.mismatches;
+            ++totals.steps;
+        }
+    }
+    ::close(fd);
+}
+
+// :   ,      W.   
+//   ,    -     (  ).
+void runSpectator(const ServerConfig& config, const std::atomic<uint32_t>& highestGameId,
+    const std::atomic<bool>& playing, ClientTotals& totals) {
+    int fd = connectTo(config);
+    if (fd == -1) {
+        totals.failed = true;
+        return;
+    }
+    LineReader reader(fd);
+    std::string line;
+    std::unordered_map<uint32_t, std::pair<unsigned, int>> seen; //       
+    while (playing.load(std::memory_order_relaxed)) {
+        uint32_t highest = highestGameId.load(std::memory_order_relaxed);
+        if (highest == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::string request;
+        for (uint32_t id = 1; id <= highest; ++id) {
+            request += "W " + std::to_string(id) + "\n";
+        }
+        if (!sendAll(fd, request)) {
+            totals.failed = true;
+            break;
+        }
+        for (uint32_t i = 0; i < highest; ++i) {
+            if (!reader.next(line)) {
+                totals.failed = true;
+                break;
+            }
+            unsigned long id = 0;
+            unsigned ply = 0;
+            char state = 0, side = 0;
+            char squares[33] = {};
+            if (std::sscanf(line.c_str(), "V %lu %u %c %c %32s", &id, &ply, &state, &side, squares) != 5) {
+                continue; //      
+            }
+            int pieces = 0;
+            for (int sq = 0; sq < 32; ++sq) {
+                pieces += squares[sq] != '.';
+            }
+            auto previous = seen.find(static_cast<uint32_t>(id));
+            if (previous != seen.end() && (ply < previous->second.first ||
+                (ply > previous->second.first && pieces > previous->second.second))) {
+                ++totals.mismatches;
+            }
+            seen[static_cast<uint32_t>(id)] = { ply, pieces };
+            ++totals.snapshotReads;
+        }
+    }
+    ::close(fd);
+}
+
+} // namespace
+
+int runServer(const ServerConfig& config)
+{
+    GameServer server(config);
+    if (!server.open()) {
+        return 1;
+    }
+    activeServer = &server;
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+    std::cout << "Server listening on "
+        << (config.unixPath.empty() ? "127.0.0.1:" + std::to_string(config.tcpPort) : config.unixPath)
+        << " with " << config.workers << " workers" << std::endl;
+    server.run();
+    activeServer = nullptr;
+    std::cout << "Move latency: " << server.latencyReport() << std::endl;
+    if (!config.eventsPath.empty()) {
+        std::cout << "Events: " << server.eventReport() << std::endl;
+    }
+    return 0;
+}
+
+int runLoadClient(const ServerConfig& config, int connections, int games, int maxPlies)
+{
+    std::vector<ClientTotals> totals(static_cast<size_t>(connections) + 1); //  - 
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> highestGameId(0);
+    std::atomic<bool> playing(true);
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < connections; ++i) {
+        threads.emplace_back(runClientConnection, std::cref(config), games, maxPlies,
+            static_cast<unsigned>(i + 1), std::ref(highestGameId), std::ref(totals[static_cast<size_t>(i)]));
+    }
+    std::thread spectator(runSpectator, std::cref(config), std::cref(highestGameId), std::cref(playing), std::ref(totals.back()));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    playing = false;
+    spectator.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    ClientTotals sum;
+    for (const auto& total : totals) {
+        sum.steps += total.steps;
+        sum.finishedGames += total.finishedGames;
+        sum.mismatches += total.mismatches;
+        sum.snapshotReads += total.snapshotReads;
+        sum.failed = sum.failed || total.failed;
+    }
+    std::cout << "Games: " << sum.finishedGames << ", steps: " << sum.steps
+        << ", mismatches: " << sum.mismatches << ", " << static_cast<uint64_t>(sum.steps / seconds) << " steps/s"
+        << ", snapshot reads: " << sum.snapshotReads << std::endl;
+
+    // ,   
+    int fd = connectTo(config);
+    if (fd != -1) {
+        LineReader reader(fd);
+        std::string line;
+        if (sendAll(fd, "S\n") && reader.next(line)) {
+            std::cout << "Server move latency: " << line.substr(2) << std::endl;
+        }
+        ::close(fd);
+    }
+    if (sum.failed) {
+        std::cerr << "Connection to server failed" << std::endl;
+    }
+    return (sum.failed || sum.mismatches != 0) ? 1 : 0;
+}
+
+#else //   epoll    Linux
+
+GameServer::GameServer(const ServerConfig& config) :
+    config(config), listenFd(-1), epollFd(-1), wakeFd(-1), stopFd(-1), running(false),
+    nextGameId(1), nextConnectionId(0), nextExpiryNs(0), journalFailed(false) {}
+
+GameServer::~GameServer() {}
+
+bool GameServer::open() {
+    std::cerr << "Server mode requires Linux (epoll)." << std::endl;
+    return false;
+}
+
+void GameServer::run() {}
+void GameServer::stop() {}
+
+std::string GameServer::latencyReport() const {
+    return LatencyHistogram().summary();
+}
+
+std::string GameServer::eventReport() const {
+    return "written=0 dropped=0";
+}
+
+int runServer(const ServerConfig& config) {
+    GameServer server(config);
+    return server.open() ? 0 : 1;
+}
+
+int runLoadClient(const ServerConfig&, int, int, int) {
+    std::cerr << "Server mode requires Linux (epoll)." << std::endl;
+    return 1;
+}
+
+#endif
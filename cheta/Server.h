@@ -0,0 +1,150 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "Game.h"
+#include "Journal.h"
+#include "EventLog.h"
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//  : Unix-,   ,  TCP  127.0.0.1:tcpPort.
+struct ServerConfig {
+    std::string unixPath;
+    int tcpPort = 0;
+    int workers = 4;
+    std::string journalPath; //   (Journal.h);  -     
+    int claimTimeoutSeconds = 300; //  :      J  
+    std::string eventsPath;  //    (EventLog.h), "-" - stdout;  -  
+};
+
+//   .    epoll  ,   
+// ;        id (  
+//   ,  Game   ).    
+//    epoll  eventfd.
+//
+//  ,    :
+//   N               -> G <id>                       
+//   M <id> <rcrc>   -> C <id> | T <id> <P|W|B|D> | E <id> <>
+//                       fromRow fromCol toRow toCol  ,  "M 7 2130"
+//   B <id>          -> P <id> <32    : . w b W B>
+//   X <id>          -> K <id>                       
+//   W <id>          -> V <id> <> <P|W|B|D> <W|B> <32 > < : 9-13, 9x18  ->
+//                           (. Snapshot.h).    epoll,
+//                        :    ,  -  .
+//   S               -> L n=<> p50=<> p99=<>
+//   J <id>          -> G <id>                         : 
+//                             ( )
+//   4    1    -  .
+//
+//          :   
+//      .      ,
+//     (    ).   
+//      J claimTimeoutSeconds,  .  
+//  , ,    ,    N  M 
+// E <id> journal failure:     ,  .
+//
+//    (eventsPath)    , , , 
+//       ;      ,    .
+class GameServer {
+public:
+    explicit GameServer(const ServerConfig& config);
+    ~GameServer();
+
+    bool open();  //    epoll. false   (  )
+    void run();   //     stop()
+    void stop();  //     
+
+    std::string latencyReport() const; // p50/p99     
+    std::string eventReport() const;   //    
+
+private:
+    enum class JobType { NEW, MOVE, BOARD, DROP };
+
+    struct Job {
+        JobType type;
+        uint64_t connectionId; // 0 -    
+        uint32_t gameId;
+        int fromRow, fromCol, toRow, toCol;
+        uint64_t receivedNs;   //     epoll
+        std::shared_ptr<SnapshotSlot> snapshots; //  NEW: ,     
+    };
+
+    struct Response {
+        uint64_t connectionId;
+        uint32_t gameId;
+        std::string line;
+    };
+
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wakeup;
+        std::deque<Job> jobs;
+        bool stopping = false;
+        std::unordered_map<uint32_t, std::unique_ptr<Game>> games; //    
+        LatencyHistogram latency;
+        uint64_t journalTicket = 0; //        
+        std::shared_ptr<EventRing> events; //     
+    };
+
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        bool waitingWritable = false;
+        std::unordered_set<uint32_t> games;
+    };
+
+    ServerConfig config;
+    int listenFd;
+    int epollFd;
+    int wakeFd;   //      
+    int stopFd;
+    std::atomic<bool> running;
+    uint32_t nextGameId;
+    uint64_t nextConnectionId;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unique_ptr<MoveJournal> journal;
+    std::unique_ptr<EventLog> eventLog;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> connections;
+    std::unordered_map<uint32_t, std::shared_ptr<const SnapshotSlot>> snapshots; //    epoll
+    std::unordered_map<uint32_t, uint64_t> unclaimed; //    ->  J (),    epoll
+    uint64_t nextExpiryNs;
+    std::atomic<bool> journalFailed;
+
+    std::mutex responsesMutex;
+    std::vector<Response> responses;
+
+    void workerLoop(Worker& worker);
+    void processJob(Worker& worker, const Job& job, std::vector<Response>& out);
+    void dispatch(const Job& job);
+
+    void acceptConnections();
+    void readConnection(uint64_t id, Connection& connection);
+    void handleLine(uint64_t id, Connection& connection, const std::string& line);
+    void deliverResponses();
+    void flushConnection(uint64_t id, Connection& connection); //    (. maxPendingOutput)
+    void closeConnection(uint64_t id);
+    void expireUnclaimed(); //  ,      claimTimeoutSeconds
+};
+
+//    SIGINT/SIGTERM      .    main.
+int runServer(const ServerConfig& config);
+
+//      : connections ,  
+// games ,        maxPlies .
+//        .
+int runLoadClient(const ServerConfig& config, int connections, int games, int maxPlies);
+
+#endif
@@ -0,0 +1,54 @@
+#include "Snapshot.h"
+#include <cstring>
+#include <thread>
+
+SnapshotSlot::SnapshotSlot() : sequence(0)
+{
+    for (auto& word : words) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+void SnapshotSlot::publish(const GameSnapshot& snapshot)
+{
+    uint64_t buffer[wordCount] = {};
+    std::memcpy(buffer, &snapshot, sizeof(snapshot));
+
+    uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); //      
+    for (int i = 0; i < wordCount; ++i) {
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+bool SnapshotSlot::read(GameSnapshot& snapshot) const
+{
+    uint64_t buffer[wordCount];
+    for (int attempt = 0; ; ++attempt) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if ((before & 1) == 0) {
+            for (int i = 0; i < wordCount; ++i) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire); //     
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        if (attempt >= 64) {
+            std::this_thread::yield(); //     -   
+        }
+    }
+    std::memcpy(&snapshot, buffer, sizeof(snapshot));
+    return true;
+}
+
+uint32_t SnapshotSlot::version() const
+{
+    return sequence.load(std::memory_order_acquire) / 2;
+}
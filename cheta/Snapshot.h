@@ -0,0 +1,42 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "Enums.h"
+#include "Notation.h"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+//      :  (  ),
+//  ,      (     ).
+struct GameSnapshot {
+    PackedPosition position;
+    GameState state = GameState::PLAYING;
+    uint32_t ply = 0;        //     
+    int8_t lastFrom = -1;    //    (0..31,   Position), -1   
+    int8_t lastTo = -1;
+    bool lastCapture = false;
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot is copied word by word");
+
+//   :   ( )    .
+// Seqlock:     ,   , 
+//     ,     .   
+//  ,       -    .
+class alignas(64) SnapshotSlot {
+public:
+    SnapshotSlot();
+
+    void publish(const GameSnapshot& snapshot); //    
+    bool read(GameSnapshot& snapshot) const;    //   . false,     
+    uint32_t version() const;                   //   (   )
+
+private:
+    static const int wordCount = (sizeof(GameSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> sequence; //  -  
+    std::atomic<uint64_t> words[wordCount];
+};
+
+#endif
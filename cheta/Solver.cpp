@@ -0,0 +1,684 @@
+#include "Solver.h"
+#include "Notation.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const uint32_t infinity = 1u << 30;
+
+//       infinity:    
+uint32_t addCapped(uint32_t a, uint32_t b) {
+    return std::min(a + b, infinity - 1);
+}
+
+enum class ProofResult { PROVEN, DISPROVEN, UNKNOWN };
+
+//  .  -    nextSibling,     .
+struct Node {
+    Position position;
+    uint32_t proof = 1;
+    uint32_t disproof = 1;
+    int32_t parent = -1;
+    int32_t firstChild = -1;
+    int32_t nextSibling = -1;
+    uint16_t depth = 0;          //  :   
+    uint8_t moveIndex = 0;       //       MoveGen::generate
+    bool pathDependent = false;  //       
+};
+
+struct SolvedEntry {
+    uint64_t key = 0;
+    uint16_t depth = 0;
+    uint8_t result = 0;    // 0 - , 1 - , 2 - 
+    uint8_t moveIndex = 0; //  ,    
+};
+
+//       .   (,  
+// )   OR-,  -  AND-.
+class ProofSearch {
+public:
+    explicit ProofSearch(size_t bytes);
+
+    // history -    ( ). stop  settled   .
+    ProofResult prove(const Position& position, PieceColor attacker, const std::vector<Position>& history,
+        std::chrono::steady_clock::time_point deadline, bool hasDeadline,
+        const std::atomic<bool>& stop, const std::atomic<bool>& settled);
+
+    //     :      
+    //  ,  -   
+    std::vector<Move> provenLine(const Position& position, PieceColor attacker) const;
+    int provenDepth(const Position& position, PieceColor attacker) const;
+
+    uint64_t getNodes() const { return nodeCount; }
+    size_t getPeakBytes() const { return peakNodes * sizeof(Node) + usedEntries * sizeof(SolvedEntry); }
+
+private:
+    std::vector<Node> nodes; //   ,     
+    size_t capacity;
+    int32_t freeList;
+    size_t peakNodes;
+    std::vector<SolvedEntry> table; //    :     
+    uint64_t tableMask;
+    size_t usedEntries;             //    (  )
+    std::vector<int32_t> stack;
+    PieceColor attacker;
+    const std::vector<Position>* history;
+    uint64_t nodeCount;
+
+    bool isOrNode(int32_t index) const { return nodes[index].position.sideToMove == attacker; }
+    int32_t allocate();
+    void releaseChildren(int32_t index);
+    void initNode(int32_t index);
+    bool expand(int32_t index);
+    void computeNumbers(int32_t index);
+    void markSolved(int32_t index);
+    int32_t selectMostProving(int32_t root) const;
+    uint64_t keyOf(const Position& position, PieceColor side) const;
+    const SolvedEntry* lookup(const Position& position, PieceColor side) const;
+    void store(const Position& position, uint16_t depth, uint8_t result, uint8_t moveIndex);
+};
+
+ProofSearch::ProofSearch(size_t bytes) :
+    freeList(-1), peakNodes(0), usedEntries(0), attacker(PieceColor::WHITE), history(nullptr), nodeCount(0)
+{
+    //   -    ( ),  - 
+    size_t entries = 2;
+    while (entries * 2 * sizeof(SolvedEntry) <= bytes / 4) entries *= 2;
+    table.resize(entries);
+    tableMask = entries - 1;
+    capacity = std::min<size_t>((bytes - entries * sizeof(SolvedEntry)) / sizeof(Node), INT32_MAX);
+    nodes.reserve(capacity);
+}
+
+int32_t ProofSearch::allocate() {
+    int32_t index;
+    if (freeList != -1) {
+        index = freeList;
+        freeList = nodes[index].nextSibling;
+    }
+    else if (nodes.size() < capacity) {
+        index = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+        peakNodes = std::max(peakNodes, nodes.size());
+    }
+    else {
+        return -1;
+    }
+    nodes[index] = Node();
+    return index;
+}
+
+void ProofSearch::releaseChildren(int32_t index) {
+    stack.clear();
+    for (int32_t child = nodes[index].firstChild; child != -1; child = nodes[child].nextSibling) {
+        stack.push_back(child);
+    }
+    nodes[index].firstChild = -1;
+    while (!stack.empty()) {
+        int32_t node = stack.back();
+        stack.pop_back();
+        for (int32_t child = nodes[node].firstChild; child != -1; child = nodes[child].nextSibling) {
+            stack.push_back(child);
+        }
+        nodes[node].firstChild = -1;
+        nodes[node].nextSibling = freeList;
+        freeList = node;
+    }
+}
+
+uint64_t ProofSearch::keyOf(const Position& position, PieceColor side) const {
+    return position.hash() ^ (side == PieceColor::WHITE ? 0 : 0x9E3779B97F4A7C15ull);
+}
+
+const SolvedEntry* ProofSearch::lookup(const Position& position, PieceColor side) const {
+    uint64_t key = keyOf(position, side);
+    const SolvedEntry* bucket = &table[key & tableMask & ~1ull];
+    if (bucket[0].result != 0 && bucket[0].key == key) return &bucket[0];
+    if (bucket[1].result != 0 && bucket[1].key == key) return &bucket[1];
+    return nullptr;
+}
+
+void ProofSearch::store(const Position& position, uint16_t depth, uint8_t result, uint8_t moveIndex) {
+    uint64_t key = keyOf(position, attacker);
+    SolvedEntry* bucket = &table[key & tableMask & ~1ull];
+    //       (     ),  - 
+    SolvedEntry& entry = (bucket[0].result == 0 || bucket[0].key == key || depth >= bucket[0].depth) ? bucket[0] : bucket[1];
+    if (entry.result == 0) {
+        ++usedEntries;
+    }
+    entry.key = key;
+    entry.depth = depth;
+    entry.result = result;
+    entry.moveIndex = moveIndex;
+}
+
+void ProofSearch::initNode(int32_t index) {
+    Node& node = nodes[index];
+    bool repeated = false;
+    for (int32_t p = node.parent; p != -1 && !repeated; p = nodes[p].parent) {
+        repeated = nodes[p].position == node.position;
+    }
+    for (size_t i = 0; i < history->size() && !repeated; ++i) {
+        repeated = (*history)[i] == node.position;
+    }
+    if (repeated) {
+        node.proof = infinity;
+        node.disproof = 0;
+        node.pathDependent = true;
+        return;
+    }
+
+    const SolvedEntry* entry = lookup(node.position, attacker);
+    if (entry) {
+        bool proven = entry->result == 1;
+        node.proof = proven ? 0 : infinity;
+        node.disproof = proven ? infinity : 0;
+        node.depth = entry->depth;
+        return;
+    }
+
+    MoveList moves;
+    MoveGen::generate(node.position, moves);
+    bool orNode = isOrNode(index);
+    if (moves.count == 0) {
+        //    ,  
+        node.proof = orNode ? infinity : 0;
+        node.disproof = orNode ? 0 : infinity;
+        return;
+    }
+    //    :   -   / 
+    node.proof = orNode ? 1 : static_cast<uint32_t>(moves.count);
+    node.disproof = orNode ? static_cast<uint32_t>(moves.count) : 1;
+}
+
+bool ProofSearch::expand(int32_t index) {
+    MoveList moves;
+    MoveGen::generate(nodes[index].position, moves);
+    bool orNode = isOrNode(index);
+    int32_t last = -1;
+    for (int i = 0; i < moves.count; ++i) {
+        int32_t child = allocate();
+        if (child == -1) {
+            releaseChildren(index);
+            return false; //   
+        }
+        Node& node = nodes[child];
+        node.position = MoveGen::apply(nodes[index].position, moves.moves[i]);
+        node.parent = index;
+        node.moveIndex = static_cast<uint8_t>(i);
+        if (last == -1) nodes[index].firstChild = child;
+        else nodes[last].nextSibling = child;
+        last = child;
+        ++nodeCount;
+        initNode(child);
+        //     :    
+        if (orNode ? node.proof == 0 : node.disproof == 0) break;
+    }
+    return true;
+}
+
+void ProofSearch::computeNumbers(int32_t index) {
+    Node& node = nodes[index];
+    bool orNode = isOrNode(index);
+    uint32_t minimum = infinity;
+    uint32_t sum = 0;
+    for (int32_t child = node.firstChild; child != -1; child = nodes[child].nextSibling) {
+        minimum = std::min(minimum, orNode ? nodes[child].proof : nodes[child].disproof);
+        sum = addCapped(sum, orNode ? nodes[child].disproof : nodes[child].proof);
+    }
+    node.proof = orNode ? minimum : sum;
+    node.disproof = orNode ? sum : minimum;
+    if (node.proof == 0 || node.disproof == 0) {
+        markSolved(index);
+    }
+}
+
+void ProofSearch::markSolved(int32_t index) {
+    Node& node = nodes[index];
+    bool orNode = isOrNode(index);
+    bool proven = node.proof == 0;
+    node.proof = proven ? 0 : infinity;
+    node.disproof = proven ? infinity : 0;
+
+    uint8_t bestMove = 0;
+    if (proven) {
+        // OR:     ; AND:   
+        int best = orNode ? INT32_MAX : -1;
+        for (int32_t child = node.firstChild; child != -1; child = nodes[child].nextSibling) {
+            const Node& c = nodes[child];
+            if (c.proof != 0) continue;
+            if (orNode ? c.depth < best : c.depth > best) {
+                best = c.depth;
+                bestMove = c.moveIndex;
+            }
+        }
+        node.depth = static_cast<uint16_t>(std::min(best + 1, 65535));
+    }
+    else {
+        //    ,        
+        bool anyDependent = false;
+        bool anyIndependent = false;
+        for (int32_t child = node.firstChild; child != -1; child = nodes[child].nextSibling) {
+            const Node& c = nodes[child];
+            if (c.disproof != 0) continue;
+            (c.pathDependent ? anyDependent : anyIndependent) = true;
+        }
+        node.pathDependent = orNode ? anyDependent : !anyIndependent;
+    }
+    if (proven || !node.pathDependent) {
+        store(node.position, node.depth, proven ? 1 : 2, bestMove);
+    }
+    releaseChildren(index); //   ,    
+}
+
+int32_t ProofSearch::selectMostProving(int32_t root) const {
+    int32_t index = root;
+    while (nodes[index].firstChild != -1) {
+        bool orNode = isOrNode(index);
+        int32_t next = -1;
+        for (int32_t child = nodes[index].firstChild; child != -1; child = nodes[child].nextSibling) {
+            if (orNode ? nodes[child].proof == nodes[index].proof : nodes[child].disproof == nodes[index].disproof) {
+                next = child;
+                break;
+            }
+        }
+        if (next == -1) break;
+        index = next;
+    }
+    return index;
+}
+
+ProofResult ProofSearch::prove(const Position& position, PieceColor attacker, const std::vector<Position>& history,
+    std::chrono::steady_clock::time_point deadline, bool hasDeadline,
+    const std::atomic<bool>& stop, const std::atomic<bool>& settled)
+{
+    this->attacker = attacker;
+    this->history = &history;
+    nodes.clear();
+    freeList = -1;
+
+    int32_t root = allocate();
+    nodes[root].position = position;
+    ++nodeCount;
+    initNode(root);
+
+    uint64_t iterations = 0;
+    while (nodes[root].proof != 0 && nodes[root].disproof != 0) {
+        if (stop || settled) return ProofResult::UNKNOWN;
+        if (hasDeadline && (++iterations & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            return ProofResult::UNKNOWN;
+        }
+        int32_t leaf = selectMostProving(root);
+        if (!expand(leaf)) return ProofResult::UNKNOWN;
+
+        //  ,   
+        for (int32_t index = leaf; index != -1; index = nodes[index].parent) {
+            uint32_t oldProof = nodes[index].proof;
+            uint32_t oldDisproof = nodes[index].disproof;
+            computeNumbers(index);
+            if (index != leaf && nodes[index].proof == oldProof && nodes[index].disproof == oldDisproof) break;
+        }
+    }
+    return nodes[root].proof == 0 ? ProofResult::PROVEN : ProofResult::DISPROVEN;
+}
+
+int ProofSearch::provenDepth(const Position& position, PieceColor attacker) const {
+    const SolvedEntry* entry = lookup(position, attacker);
+    return entry && entry->result == 1 ? entry->depth : 0;
+}
+
+std::vector<Move> ProofSearch::provenLine(const Position& position, PieceColor attacker) const {
+    std::vector<Move> line;
+    Position current = position;
+    while (line.size() < 256) {
+        MoveList moves;
+        MoveGen::generate(current, moves);
+        const SolvedEntry* entry = lookup(current, attacker);
+        if (moves.count == 0 || !entry || entry->result != 1) break;
+        int chosen = -1;
+        if (current.sideToMove == attacker) {
+            chosen = entry->moveIndex < moves.count ? entry->moveIndex : -1;
+        }
+        else {
+            int bestDepth = -1;
+            for (int i = 0; i < moves.count; ++i) {
+                const SolvedEntry* child = lookup(MoveGen::apply(current, moves.moves[i]), attacker);
+                if (child && child->result == 1 && child->depth > bestDepth) {
+                    bestDepth = child->depth;
+                    chosen = i;
+                }
+            }
+        }
+        if (chosen == -1) break; //    
+        line.push_back(moves.moves[chosen]);
+        current = MoveGen::apply(current, moves.moves[chosen]);
+    }
+    return line;
+}
+
+struct ChildResult {
+    ProofResult result = ProofResult::UNKNOWN;
+    std::vector<Move> line;
+    int depth = 0;
+};
+
+//   attacker  position.      
+//  ;     ,   .
+ProofResult proveRoot(std::vector<std::unique_ptr<ProofSearch>>& searches, const Position& position,
+    PieceColor attacker, std::chrono::steady_clock::time_point deadline, bool hasDeadline,
+    const std::atomic<bool>& stop, std::vector<Move>& line)
+{
+    line.clear();
+    if (searches.size() == 1) {
+        std::atomic<bool> settled(false);
+        std::vector<Position> history;
+        ProofResult result = searches[0]->prove(position, attacker, history, deadline, hasDeadline, stop, settled);
+        if (result == ProofResult::PROVEN) {
+            line = searches[0]->provenLine(position, attacker);
+        }
+        return result;
+    }
+
+    MoveList moves;
+    MoveGen::generate(position, moves);
+    bool orRoot = position.sideToMove == attacker;
+    if (moves.count == 0) {
+        return orRoot ? ProofResult::DISPROVEN : ProofResult::PROVEN;
+    }
+
+    std::vector<ChildResult> results(moves.count);
+    std::vector<Position> history(1, position);
+    std::atomic<int> next(0);
+    std::atomic<bool> settled(false);
+    auto work = [&](ProofSearch& search) {
+        while (!settled) {
+            int i = next++;
+            if (i >= moves.count) break;
+            Position child = MoveGen::apply(position, moves.moves[i]);
+            ProofResult result = search.prove(child, attacker, history, deadline, hasDeadline, stop, settled);
+            if (result == ProofResult::PROVEN) {
+                results[i].line = search.provenLine(child, attacker);
+                results[i].depth = search.provenDepth(child, attacker);
+            }
+            results[i].result = result;
+            if (result == (orRoot ? ProofResult::PROVEN : ProofResult::DISPROVEN)) {
+                settled = true;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < searches.size(); ++t) {
+        threads.emplace_back(work, std::ref(*searches[t]));
+    }
+    work(*searches[0]);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // OR:    ; AND:  
+    ProofResult decisive = orRoot ? ProofResult::PROVEN : ProofResult::DISPROVEN;
+    int chosen = -1;
+    bool unknown = false;
+    for (int i = 0; i < moves.count; ++i) {
+        if (results[i].result == decisive) {
+            chosen = i;
+            break;
+        }
+        unknown = unknown || results[i].result == ProofResult::UNKNOWN;
+    }
+    if (chosen == -1 && unknown) {
+        return ProofResult::UNKNOWN;
+    }
+    ProofResult result = chosen != -1 ? decisive : (orRoot ? ProofResult::DISPROVEN : ProofResult::PROVEN);
+    if (result == ProofResult::PROVEN) {
+        if (!orRoot) {
+            chosen = 0; //     
+            for (int i = 1; i < moves.count; ++i) {
+                if (results[i].depth > results[chosen].depth) chosen = i;
+            }
+        }
+        line.push_back(moves.moves[chosen]);
+        line.insert(line.end(), results[chosen].line.begin(), results[chosen].line.end());
+    }
+    return result;
+}
+
+//     ,   .   
+//    ,     : 
+//      ,    ,     
+//   (    ).    , 
+//  :  ,      
+//     ,         .
+class Retrograde {
+public:
+    // false -   maxPositions,    
+    bool build(const Position& root, size_t maxPositions, std::chrono::steady_clock::time_point deadline,
+        bool hasDeadline, const std::atomic<bool>& stop);
+    SolveOutcome solve(std::vector<Move>& line) const;
+
+    uint64_t getPositions() const { return positions.size(); }
+    size_t getBytes() const;
+
+private:
+    struct PositionHash {
+        size_t operator()(const Position& position) const { return static_cast<size_t>(position.hash()); }
+    };
+
+    std::vector<Position> positions;  // positions[0] - 
+    std::vector<uint32_t> firstChild; //   v - children[firstChild[v] .. firstChild[v + 1])
+    std::vector<int32_t> children;    //   MoveGen::generate
+    std::unordered_map<Position, int32_t, PositionHash> index;
+
+    //    attacker   , -1 -  
+    std::vector<int32_t> winDistance(PieceColor attacker) const;
+    std::vector<Move> line(const std::vector<int32_t>& distance) const;
+};
+
+bool Retrograde::build(const Position& root, size_t maxPositions, std::chrono::steady_clock::time_point deadline,
+    bool hasDeadline, const std::atomic<bool>& stop)
+{
+    positions.assign(1, root);
+    firstChild.assign(1, 0);
+    children.clear();
+    index.clear();
+    index.emplace(root, 0);
+    MoveList moves;
+    for (size_t v = 0; v < positions.size(); ++v) {
+        if ((v & 1023) == 0 && (stop || (hasDeadline && std::chrono::steady_clock::now() >= deadline))) return false;
+        Position current = positions[v];
+        MoveGen::generate(current, moves);
+        for (int i = 0; i < moves.count; ++i) {
+            auto found = index.emplace(MoveGen::apply(current, moves.moves[i]), static_cast<int32_t>(positions.size()));
+            if (found.second) {
+                if (positions.size() >= maxPositions) return false;
+                positions.push_back(found.first->first);
+            }
+            children.push_back(found.first->second);
+        }
+        firstChild.push_back(static_cast<uint32_t>(children.size()));
+    }
+    return true;
+}
+
+size_t Retrograde::getBytes() const {
+    //  unordered_map - ,     ,  
+    size_t nodeBytes = sizeof(Position) + sizeof(int32_t) + sizeof(void*);
+    return positions.capacity() * sizeof(Position) + firstChild.capacity() * sizeof(uint32_t)
+        + children.capacity() * sizeof(int32_t) * 2 + index.size() * nodeBytes + index.bucket_count() * sizeof(void*);
+}
+
+std::vector<int32_t> Retrograde::winDistance(PieceColor attacker) const {
+    size_t count = positions.size();
+    //  :    -     ( ,   children)
+    std::vector<uint32_t> firstParent(count + 1, 0);
+    for (int32_t child : children) ++firstParent[child + 1];
+    for (size_t v = 0; v < count; ++v) firstParent[v + 1] += firstParent[v];
+    std::vector<int32_t> parents(children.size());
+    std::vector<uint32_t> fill(firstParent.begin(), firstParent.end() - 1);
+    for (size_t v = 0; v < count; ++v) {
+        for (uint32_t e = firstChild[v]; e < firstChild[v + 1]; ++e) {
+            parents[fill[children[e]]++] = static_cast<int32_t>(v);
+        }
+    }
+
+    //    :      ,
+    //  ,     ,     
+    std::vector<int32_t> distance(count, -1);
+    std::vector<uint32_t> remaining(count);
+    std::vector<int32_t> queue;
+    queue.reserve(count);
+    for (size_t v = 0; v < count; ++v) {
+        remaining[v] = firstChild[v + 1] - firstChild[v];
+        if (remaining[v] == 0 && positions[v].sideToMove != attacker) {
+            distance[v] = 0; //    ,  
+            queue.push_back(static_cast<int32_t>(v));
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t v = queue[head];
+        for (uint32_t e = firstParent[v]; e < firstParent[v + 1]; ++e) {
+            int32_t p = parents[e];
+            if (distance[p] != -1) continue;
+            if (positions[p].sideToMove == attacker || --remaining[p] == 0) {
+                distance[p] = distance[v] + 1;
+                queue.push_back(p);
+            }
+        }
+    }
+    return distance;
+}
+
+std::vector<Move> Retrograde::line(const std::vector<int32_t>& distance) const {
+    std::vector<Move> result;
+    MoveList moves;
+    int32_t v = 0;
+    while (distance[v] > 0) {
+        MoveGen::generate(positions[v], moves);
+        for (uint32_t e = firstChild[v]; e < firstChild[v + 1]; ++e) {
+            if (distance[children[e]] == distance[v] - 1) {
+                result.push_back(moves.moves[e - firstChild[v]]);
+                v = children[e];
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+SolveOutcome Retrograde::solve(std::vector<Move>& result) const {
+    PieceColor side = positions[0].sideToMove;
+    PieceColor opponent = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+    std::vector<int32_t> distance = winDistance(side);
+    if (distance[0] != -1) {
+        result = line(distance);
+        return SolveOutcome::WIN;
+    }
+    distance = winDistance(opponent);
+    if (distance[0] != -1) {
+        result = line(distance);
+        return SolveOutcome::LOSS;
+    }
+    result.clear();
+    return SolveOutcome::NO_FORCED_RESULT;
+}
+
+const char* colorName(PieceColor color) {
+    return color == PieceColor::WHITE ? "White" : "Black";
+}
+
+} // namespace
+
+Solver::Solver(const SolverConfig& config) : config(config), stopRequested(false) {
+}
+
+SolveReport Solver::solve(const Position& position) {
+    auto started = std::chrono::steady_clock::now();
+    auto deadline = started + std::chrono::milliseconds(config.timeMs);
+    bool hasDeadline = config.timeMs > 0;
+
+    //   (   )     
+    //  .      ,  128   .
+    SolveReport report;
+    {
+        Retrograde retrograde;
+        bool built = retrograde.build(position, (config.memoryMb << 20) / 16 / 128, deadline, hasDeadline, stopRequested);
+        report.nodes = retrograde.getPositions();
+        report.peakBytes = retrograde.getBytes();
+        if (built) {
+            report.outcome = retrograde.solve(report.line);
+            report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            return report;
+        }
+    }
+
+    int threads = std::max(1, config.threads);
+    std::vector<std::unique_ptr<ProofSearch>> searches;
+    for (int i = 0; i < threads; ++i) {
+        searches.push_back(std::make_unique<ProofSearch>((config.memoryMb << 20) / threads));
+    }
+
+    //    ,  ,  - 
+    PieceColor side = position.sideToMove;
+    PieceColor opponent = side == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+    ProofResult result = proveRoot(searches, position, side, deadline, hasDeadline, stopRequested, report.line);
+    if (result == ProofResult::PROVEN) {
+        report.outcome = SolveOutcome::WIN;
+    }
+    else if (result == ProofResult::DISPROVEN) {
+        result = proveRoot(searches, position, opponent, deadline, hasDeadline, stopRequested, report.line);
+        report.outcome = result == ProofResult::PROVEN ? SolveOutcome::LOSS :
+            (result == ProofResult::DISPROVEN ? SolveOutcome::NO_FORCED_RESULT : SolveOutcome::UNKNOWN);
+    }
+
+    size_t searchBytes = 0;
+    for (const auto& search : searches) {
+        report.nodes += search->getNodes();
+        searchBytes += search->getPeakBytes();
+    }
+    report.peakBytes = std::max(report.peakBytes, searchBytes); //     
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+int runSolver(const std::string& notation, const SolverConfig& config) {
+    Position position;
+    if (!Notation::parse(notation, position)) {
+        std::cerr << "Bad position: " << notation << std::endl;
+        return 1;
+    }
+    Solver solver(config);
+    SolveReport report = solver.solve(position);
+
+    const char* side = colorName(position.sideToMove);
+    std::cout << "Position: " << Notation::toString(position) << std::endl;
+    switch (report.outcome) {
+    case SolveOutcome::WIN:
+        std::cout << "Result: " << side << " to move wins" << std::endl;
+        break;
+    case SolveOutcome::LOSS:
+        std::cout << "Result: " << side << " to move loses" << std::endl;
+        break;
+    case SolveOutcome::NO_FORCED_RESULT:
+        std::cout << "Result: no forced win for either side (repetition)" << std::endl;
+        break;
+    default:
+        std::cout << "Result: unknown (memory or time limit reached)" << std::endl;
+        break;
+    }
+    if (!report.line.empty()) {
+        std::cout << "Line:";
+        for (const Move& move : report.line) {
+            std::cout << ' ' << MoveGen::toString(move);
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Nodes: " << report.nodes << " (" << static_cast<uint64_t>(report.nodes / std::max(report.seconds, 1e-9))
+        << " nodes/s), peak memory " << report.peakBytes / (1024.0 * 1024.0) << " MB, time " << report.seconds
+        << " s, threads " << std::max(1, config.threads) << std::endl;
+    return report.outcome == SolveOutcome::UNKNOWN ? 2 : 0;
+}
@@ -0,0 +1,59 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "MoveGen.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SolverConfig {
+    size_t memoryMb = 256; //        
+    int threads = 1;       //  1 -      
+    int timeMs = 0;        // 0 -   
+};
+
+enum class SolveOutcome {
+    WIN,              // ,  ,    
+    LOSS,             //     
+    NO_FORCED_RESULT, //        (  )
+    UNKNOWN           //    
+};
+
+struct SolveReport {
+    SolveOutcome outcome = SolveOutcome::UNKNOWN;
+    std::vector<Move> line; //   ( WIN  LOSS)
+    uint64_t nodes = 0;     //       
+    double seconds = 0;
+    size_t peakBytes = 0;   //       
+};
+
+//        (proof-number search).
+//  -     (    ),   MoveGen,
+//        ,   Board.   
+//       .
+//
+//       :    , 
+//    ,   -      .
+//   ,  UNKNOWN.
+//
+//           ,  
+//      (   )  
+//     ,       - .
+class Solver {
+public:
+    explicit Solver(const SolverConfig& config);
+
+    SolveReport solve(const Position& position);
+    void stop() { stopRequested = true; } //     
+
+private:
+    SolverConfig config;
+    std::atomic<bool> stopRequested;
+};
+
+//  --solve:     FEN   ,   
+int runSolver(const std::string& notation, const SolverConfig& config);
+
+#endif
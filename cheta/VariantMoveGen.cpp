@@ -0,0 +1,64 @@
+#include "VariantMoveGen.h"
+#include "Notation.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+template <typename Rules>
+uint64_t perft(const VariantPosition<Rules>& position, int depth) {
+    VariantMoveList<Rules> list;
+    VariantMoveGen<Rules>::generate(position, list);
+    if (depth <= 1) {
+        return depth == 1 ? static_cast<uint64_t>(list.count) : 1;
+    }
+    uint64_t nodes = 0;
+    for (int i = 0; i < list.count; ++i) {
+        nodes += perft<Rules>(VariantMoveGen<Rules>::apply(position, list.moves[i]), depth - 1);
+    }
+    return nodes;
+}
+
+template <typename Rules>
+int runPerftFor(int depth, const std::string& notation) {
+    VariantPosition<Rules> start = VariantPosition<Rules>::initial();
+    if (!notation.empty()) {
+        Position position;
+        if constexpr (Rules::boardSize == 8) {
+            if (!Notation::parse(notation, position)) {
+                std::cerr << "Bad position: " << notation << std::endl;
+                return 1;
+            }
+            start.white = position.white;
+            start.black = position.black;
+            start.kings = position.kings;
+            start.sideToMove = position.sideToMove;
+        }
+        else {
+            std::cerr << "Positions are only supported for 8x8 variants" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Variant: " << Rules::name << std::endl;
+    for (int d = 1; d <= depth; ++d) {
+        auto started = std::chrono::steady_clock::now();
+        uint64_t nodes = perft<Rules>(start, d);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "perft " << d << ": " << nodes << " (" << seconds << " s, "
+            << static_cast<uint64_t>(nodes / std::max(seconds, 1e-9)) << " nodes/s)" << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int runPerft(const std::string& variant, int depth, const std::string& notation) {
+    //       - ,   
+    if (variant == HouseRules::name) return runPerftFor<HouseRules>(depth, notation);
+    if (variant == RussianRules::name) return runPerftFor<RussianRules>(depth, notation);
+    if (variant == EnglishRules::name) return runPerftFor<EnglishRules>(depth, notation);
+    if (variant == BrazilianRules::name) return runPerftFor<BrazilianRules>(depth, notation);
+    if (variant == InternationalRules::name) return runPerftFor<InternationalRules>(depth, notation);
+    std::cerr << "Unknown variant: " << variant << " (house, russian, english, brazilian, international)" << std::endl;
+    return 1;
+}
@@ -0,0 +1,399 @@
+#ifndef VARIANT_MOVEGEN_H
+#define VARIANT_MOVEGEN_H
+
+#include "Enums.h"
+#include "Rules.h"
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+//    :      Rules::boardSize
+template <typename Rules>
+struct VariantPosition {
+    using Mask = typename Rules::Mask;
+    using Geometry = BoardGeometry<Rules::boardSize>;
+
+    Mask white = 0;
+    Mask black = 0;
+    Mask kings = 0;
+    PieceColor sideToMove = PieceColor::WHITE;
+
+    Mask own() const { return sideToMove == PieceColor::WHITE ? white : black; }
+    Mask enemy() const { return sideToMove == PieceColor::WHITE ? black : white; }
+    Mask occupied() const { return white | black; }
+
+    bool operator==(const VariantPosition& other) const {
+        return white == other.white && black == other.black && kings == other.kings && sideToMove == other.sideToMove;
+    }
+
+    //    rowsPerSide ,  - 
+    static VariantPosition initial() {
+        VariantPosition position;
+        int count = Rules::rowsPerSide * Geometry::half;
+        for (int sq = 0; sq < count; ++sq) {
+            position.white |= Mask(1) << sq;
+            position.black |= Mask(1) << (Geometry::squares - 1 - sq);
+        }
+        return position;
+    }
+};
+
+template <typename Rules>
+struct VariantMove {
+    using Mask = typename Rules::Mask;
+    static const int maxPath = Rules::rowsPerSide * Rules::boardSize / 2 + 1; //     
+
+    uint8_t from = 0;
+    uint8_t to = 0;
+    uint8_t pathLength = 0;
+    bool promotes = false;
+    Mask captured = 0;
+    uint8_t path[maxPath] = {};
+
+    bool isCapture() const { return captured != 0; }
+    bool operator==(const VariantMove& other) const {
+        return from == other.from && to == other.to && captured == other.captured &&
+            pathLength == other.pathLength && std::memcmp(path, other.path, pathLength) == 0;
+    }
+    int captureCount() const {
+        int count = 0;
+        for (Mask mask = captured; mask; mask &= mask - 1) ++count;
+        return count;
+    }
+};
+
+template <typename Rules>
+struct VariantMoveList {
+    static const int capacity = 256;
+    VariantMove<Rules> moves[capacity];
+    int count = 0;
+};
+
+//   :    
+template <typename Rules, PieceColor side>
+constexpr typename Rules::Mask promotionRowOf() {
+    using Geometry = BoardGeometry<Rules::boardSize>;
+    typename Rules::Mask row = 0;
+    for (int i = 0; i < Geometry::half; ++i) {
+        row |= typename Rules::Mask(1) << (side == PieceColor::WHITE ? Geometry::squares - 1 - i : i);
+    }
+    return row;
+}
+
+//     Rules.    -  Rules, 
+//   if constexpr.      
+//   ,  ,     ,   
+//   .   (  ,    ,  
+//  ),      ,   .
+//       generate/hasCapture:    
+//    -   side.
+template <typename Rules>
+class VariantMoveGen {
+public:
+    using Mask = typename Rules::Mask;
+    using Position = VariantPosition<Rules>;
+    using Move = VariantMove<Rules>;
+    using MoveList = VariantMoveList<Rules>;
+    using Geometry = BoardGeometry<Rules::boardSize>;
+
+    static void generate(const Position& position, MoveList& list);
+    static bool hasCapture(const Position& position);
+    static Position apply(const Position& position, const Move& move);
+    static std::string toString(const Move& move);
+
+private:
+    static Mask bit(int sq) { return Mask(1) << sq; }
+    static int next(int sq, int dir) { return Geometry::table.next[sq][dir]; }
+    template <PieceColor side>
+    static constexpr bool isForward(int dir) { return side == PieceColor::WHITE ? dir < 2 : dir >= 2; }
+
+    static int lowestBit(Mask mask) {
+        int sq = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            ++sq;
+        }
+        return sq;
+    }
+
+    static int countBits(Mask mask) {
+        int count = 0;
+        for (; mask; mask &= mask - 1) ++count;
+        return count;
+    }
+
+    template <PieceColor side>
+    static constexpr Mask promotionRow = promotionRowOf<Rules, side>();
+
+    template <PieceColor side>
+    struct CaptureSearch {
+        MoveList* list;
+        Mask enemies;       //  ,    
+        Mask occupied;      // :   ,    -   
+        int depth;          //    
+        int best;           //     (  )
+        Move current;
+
+        void record(int to, bool promotes);
+        void land(int captured, int to, bool king);
+        bool extend(int sq, bool king);
+    };
+
+    template <PieceColor side> static void generateFor(const Position& position, MoveList& list);
+    template <PieceColor side> static bool hasCaptureFor(const Position& position);
+    template <PieceColor side> static bool canCaptureFrom(int sq, bool king, Mask enemies, Mask occupied);
+};
+
+template <typename Rules>
+template <PieceColor side>
+void VariantMoveGen<Rules>::CaptureSearch<side>::record(int to, bool promotes) {
+    if constexpr (Rules::maximumCapture) {
+        if (depth < best) return;
+        if (depth > best) {
+            best = depth;
+            list->count = 0; //     
+        }
+    }
+    if constexpr (!Rules::removeCapturedImmediately) {
+        for (int i = 0; i < list->count; ++i) {
+            const Move& other = list->moves[i];
+            if (other.from == current.from && other.to == to && other.captured == current.captured) return;
+        }
+    }
+    //        :  - 
+    // ,      
+    assert(list->count < MoveList::capacity && "move list overflow: too many capture sequences");
+    if (list->count >= MoveList::capacity) return; //  assert -     
+    Move& move = list->moves[list->count++];
+    move = current;
+    move.to = static_cast<uint8_t>(to);
+    move.promotes = promotes;
+}
+
+template <typename Rules>
+template <PieceColor side>
+void VariantMoveGen<Rules>::CaptureSearch<side>::land(int captured, int to, bool king) {
+    Mask savedEnemies = enemies;
+    Mask savedOccupied = occupied;
+    Mask savedCaptured = current.captured;
+    uint8_t savedLength = current.pathLength;
+
+    enemies &= ~bit(captured);
+    if constexpr (Rules::removeCapturedImmediately) {
+        occupied &= ~bit(captured);
+    }
+    current.captured |= bit(captured);
+    current.path[current.pathLength++] = static_cast<uint8_t>(to);
+    ++depth;
+
+    bool onLastRow = !king && (promotionRow<side> & bit(to));
+    if constexpr (Rules::promotion == CapturePromotion::ENDS_MOVE) {
+        if (onLastRow || !extend(to, king)) {
+            record(to, onLastRow);
+        }
+    }
+    else if constexpr (Rules::promotion == CapturePromotion::CONTINUES_AS_KING) {
+        bool wasPromoted = current.promotes;
+        current.promotes = current.promotes || onLastRow;
+        if (!extend(to, king || onLastRow)) {
+            record(to, current.promotes);
+        }
+        current.promotes = wasPromoted;
+    }
+    else {
+        //     :   ,   
+        if (!extend(to, king)) {
+            record(to, onLastRow);
+        }
+    }
+
+    --depth;
+    enemies = savedEnemies;
+    occupied = savedOccupied;
+    current.captured = savedCaptured;
+    current.pathLength = savedLength;
+}
+
+template <typename Rules>
+template <PieceColor side>
+bool VariantMoveGen<Rules>::CaptureSearch<side>::extend(int sq, bool king) {
+    if constexpr (Rules::maximumCapture) {
+        if (depth + countBits(enemies) < best) {
+            return true; //      ; true -     
+        }
+    }
+    bool found = false;
+    for (int dir = 0; dir < 4; ++dir) {
+        if (!king) {
+            if constexpr (!Rules::menCaptureBackward) {
+                if (!isForward<side>(dir)) continue;
+            }
+            int middle = next(sq, dir);
+            if (middle < 0 || !(enemies & bit(middle))) continue;
+            int to = next(middle, dir);
+            if (to < 0 || (occupied & bit(to))) continue;
+            found = true;
+            land(middle, to, false);
+        }
+        else if constexpr (Rules::flyingKings) {
+            int middle = next(sq, dir);
+            while (middle >= 0 && !(occupied & bit(middle))) middle = next(middle, dir);
+            if (middle < 0 || !(enemies & bit(middle))) continue;
+            //          
+            for (int to = next(middle, dir); to >= 0 && !(occupied & bit(to)); to = next(to, dir)) {
+                found = true;
+                land(middle, to, true);
+            }
+        }
+        else {
+            int middle = next(sq, dir);
+            if (middle < 0 || !(enemies & bit(middle))) continue;
+            int to = next(middle, dir);
+            if (to < 0 || (occupied & bit(to))) continue;
+            found = true;
+            land(middle, to, true);
+        }
+    }
+    return found;
+}
+
+template <typename Rules>
+template <PieceColor side>
+bool VariantMoveGen<Rules>::canCaptureFrom(int sq, bool king, Mask enemies, Mask occupied) {
+    for (int dir = 0; dir < 4; ++dir) {
+        if constexpr (!Rules::menCaptureBackward) {
+            if (!king && !isForward<side>(dir)) continue;
+        }
+        int middle = next(sq, dir);
+        if constexpr (Rules::flyingKings) {
+            if (king) {
+                while (middle >= 0 && !(occupied & bit(middle))) middle = next(middle, dir);
+            }
+        }
+        if (middle < 0 || !(enemies & bit(middle))) continue;
+        int to = next(middle, dir);
+        if (to >= 0 && !(occupied & bit(to))) return true;
+    }
+    return false;
+}
+
+template <typename Rules>
+bool VariantMoveGen<Rules>::hasCapture(const Position& position) {
+    return position.sideToMove == PieceColor::WHITE ?
+        hasCaptureFor<PieceColor::WHITE>(position) : hasCaptureFor<PieceColor::BLACK>(position);
+}
+
+template <typename Rules>
+template <PieceColor side>
+bool VariantMoveGen<Rules>::hasCaptureFor(const Position& position) {
+    Mask enemies = side == PieceColor::WHITE ? position.black : position.white;
+    Mask occupied = position.occupied();
+    for (Mask pieces = side == PieceColor::WHITE ? position.white : position.black; pieces; pieces &= pieces - 1) {
+        int sq = lowestBit(pieces);
+        if (canCaptureFrom<side>(sq, (position.kings & bit(sq)) != 0, enemies, occupied & ~bit(sq))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Rules>
+void VariantMoveGen<Rules>::generate(const Position& position, MoveList& list) {
+    if (position.sideToMove == PieceColor::WHITE) {
+        generateFor<PieceColor::WHITE>(position, list);
+    }
+    else {
+        generateFor<PieceColor::BLACK>(position, list);
+    }
+}
+
+template <typename Rules>
+template <PieceColor side>
+void VariantMoveGen<Rules>::generateFor(const Position& position, MoveList& list) {
+    //      ,        4  
+    //    :     4 * squares   
+    static_assert(4 * Geometry::squares <= MoveList::capacity, "move list must hold every quiet move");
+    list.count = 0;
+    Mask own = side == PieceColor::WHITE ? position.white : position.black;
+    Mask enemy = side == PieceColor::WHITE ? position.black : position.white;
+    Mask occupied = position.occupied();
+
+    //  :   ,   
+    CaptureSearch<side> search;
+    search.list = &list;
+    search.depth = 0;
+    search.best = 1;
+    for (Mask pieces = own; pieces; pieces &= pieces - 1) {
+        int sq = lowestBit(pieces);
+        search.enemies = enemy;
+        search.occupied = occupied & ~bit(sq);
+        search.current = Move();
+        search.current.from = static_cast<uint8_t>(sq);
+        search.extend(sq, (position.kings & bit(sq)) != 0);
+    }
+    if (list.count > 0) {
+        return;
+    }
+
+    for (Mask pieces = own; pieces; pieces &= pieces - 1) {
+        int sq = lowestBit(pieces);
+        bool king = (position.kings & bit(sq)) != 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (!king && !isForward<side>(dir)) continue; //    
+            for (int to = next(sq, dir); to >= 0 && !(occupied & bit(to)); to = next(to, dir)) {
+                Move& move = list.moves[list.count++];
+                move = Move();
+                move.from = static_cast<uint8_t>(sq);
+                move.to = static_cast<uint8_t>(to);
+                move.pathLength = 1;
+                move.path[0] = static_cast<uint8_t>(to);
+                move.promotes = !king && (promotionRow<side> & bit(to));
+                if constexpr (!Rules::flyingKings) {
+                    break;
+                }
+                if (!king) break; //  -    
+            }
+        }
+    }
+}
+
+template <typename Rules>
+typename VariantMoveGen<Rules>::Position VariantMoveGen<Rules>::apply(const Position& position, const Move& move) {
+    Position next = position;
+    Mask fromBit = bit(move.from);
+    Mask toBit = bit(move.to);
+    if (position.sideToMove == PieceColor::WHITE) {
+        next.white = (position.white & ~fromBit) | toBit;
+        next.black = position.black & ~move.captured;
+        next.sideToMove = PieceColor::BLACK;
+    }
+    else {
+        next.black = (position.black & ~fromBit) | toBit;
+        next.white = position.white & ~move.captured;
+        next.sideToMove = PieceColor::WHITE;
+    }
+    bool king = (position.kings & fromBit) != 0 || move.promotes;
+    next.kings = position.kings & ~(fromBit | move.captured);
+    if (king) {
+        next.kings |= toBit;
+    }
+    return next;
+}
+
+template <typename Rules>
+std::string VariantMoveGen<Rules>::toString(const Move& move) {
+    std::string text = std::to_string(move.from + 1);
+    char separator = move.isCapture() ? 'x' : '-';
+    for (int i = 0; i < move.pathLength; ++i) {
+        text += separator;
+        text += std::to_string(move.path[i] + 1);
+    }
+    return text;
+}
+
+//  --perft:     depth   variant (house, russian,
+// english, brazilian, international)      FEN ( 8x8)
+int runPerft(const std::string& variant, int depth, const std::string& notation);
+
+#endif
@@ -0,0 +1,441 @@
+//  API Board ( Game::checkGameEnd)     corpus.txt.
+//      :    (  ), 
+// ,    .     JSON (--json) 
+//     (--baseline):     1.
+
+#include "Board.h"
+#include "Game.h"
+#include "Player.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef CHETA_INSTRUMENT
+// operator new    Profiler.cpp -   
+#include "Profiler.h"
+static uint64_t allocationCount() {
+    return Profiler::allocations();
+}
+#else
+//    ( )
+static uint64_t allocations = 0;
+
+static uint64_t allocationCount() {
+    return allocations;
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+//     Game (   Game.h)
+class GameBench {
+public:
+    static std::unique_ptr<Game> create(const std::string& notation) {
+        auto game = std::make_unique<Game>(new RemotePlayer("White", PieceColor::WHITE), new RemotePlayer("Black", PieceColor::BLACK));
+        PieceColor side = PieceColor::WHITE;
+        game->board.loadPosition(notation, &side);
+        game->currentPlayerIndex = side == PieceColor::WHITE ? 0 : 1;
+        return game;
+    }
+
+    //      :   
+    static bool checkGameEnd(Game& game) {
+        bool ended = game.checkGameEnd();
+        game.gameState = GameState::PLAYING;
+        return ended;
+    }
+};
+
+namespace {
+
+struct BenchConfig {
+    std::string corpusPath;
+    std::string jsonPath;
+    std::string baselinePath;
+    int samples = 10;
+    int minTimeMs = 20;         //    
+    double thresholdPercent = 10;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string category;
+    double nsPerOp = 0;        //   
+    double stddevPercent = 0;  //       
+    double allocsPerOp = 0;
+    uint64_t ops = 0;
+};
+
+//        
+struct Category {
+    std::string name;
+    std::vector<std::string> notations;
+    std::vector<std::unique_ptr<Board>> boards;
+    std::vector<PieceColor> sides;
+    std::vector<std::unique_ptr<Game>> games;
+
+    struct Square { int board, row, col; };
+    struct Step { int board, fromRow, fromCol, toRow, toCol; };
+    std::vector<Square> pieces;       //  ,  
+    std::vector<Step> candidates;     //   1  2       
+    std::vector<Step> jumps;          //     2   
+    std::vector<Step> quietMoves;     //      ( makeMove)
+};
+
+volatile uint64_t sink = 0; //     
+
+bool loadCorpus(const std::string& path, std::vector<Category>& categories) {
+    std::ifstream input(path);
+    if (!input) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        size_t space = line.find(' ');
+        if (space == std::string::npos) continue;
+        std::string name = line.substr(0, space);
+        std::string notation = line.substr(space + 1);
+        auto it = std::find_if(categories.begin(), categories.end(), [&name](const Category& c) { return c.name == name; });
+        if (it == categories.end()) {
+            categories.push_back(Category());
+            categories.back().name = name;
+            it = categories.end() - 1;
+        }
+        auto board = std::make_unique<Board>();
+        PieceColor side = PieceColor::WHITE;
+        if (!board->loadPosition(notation, &side)) {
+            std::cerr << "Bad position in corpus: " << notation << std::endl;
+            continue;
+        }
+        it->notations.push_back(notation);
+        it->boards.push_back(std::move(board));
+        it->sides.push_back(side);
+        it->games.push_back(GameBench::create(notation));
+    }
+    return !categories.empty();
+}
+
+void prepare(Category& category) {
+    for (size_t b = 0; b < category.boards.size(); ++b) {
+        const Board& board = *category.boards[b];
+        PieceColor side = category.sides[b];
+        int size = board.getBoardSize();
+        bool captureRequired = board.hasRequiredJumps(side);
+        for (int row = 0; row < size; ++row) {
+            for (int col = 0; col < size; ++col) {
+                if (board.getPieceColor(row, col) != side) continue;
+                int index = static_cast<int>(b);
+                category.pieces.push_back({ index, row, col });
+                for (int dr = -1; dr <= 1; dr += 2) {
+                    for (int dc = -1; dc <= 1; dc += 2) {
+                        for (int dist = 1; dist < size; ++dist) {
+                            int toRow = row + dist * dr;
+                            int toCol = col + dist * dc;
+                            if (!board.isInsideBoard(toRow, toCol)) break;
+                            Category::Step step = { index, row, col, toRow, toCol };
+                            if (dist <= 2) category.candidates.push_back(step);
+                            if (dist >= 2) category.jumps.push_back(step);
+                            bool promotes = (side == PieceColor::WHITE && toRow == size - 1) || (side == PieceColor::BLACK && toRow == 0);
+                            if (dist == 1 && !captureRequired && !promotes && board.isValidMove(row, col, toRow, toCol, side)) {
+                                category.quietMoves.push_back(step);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// : batch         
+bool measure(const BenchConfig& config, const std::string& name, const Category& category,
+    const std::function<uint64_t()>& batch, BenchResult& result)
+{
+    using Clock = std::chrono::steady_clock;
+    auto started = Clock::now();
+    uint64_t opsPerBatch = batch(); //   
+    if (opsPerBatch == 0) {
+        return false;
+    }
+    double batchNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - started).count());
+    uint64_t repeats = std::max<uint64_t>(1, static_cast<uint64_t>(config.minTimeMs * 1e6 / std::max(batchNs, 1.0)));
+
+    std::vector<double> samples;
+    uint64_t startAllocations = allocationCount();
+    for (int s = 0; s < config.samples; ++s) {
+        auto sampleStart = Clock::now();
+        for (uint64_t r = 0; r < repeats; ++r) {
+            batch();
+        }
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - sampleStart).count());
+        samples.push_back(ns / (repeats * opsPerBatch));
+    }
+    uint64_t totalOps = repeats * opsPerBatch * config.samples;
+
+    double mean = 0;
+    for (double sample : samples) mean += sample;
+    mean /= samples.size();
+    double variance = 0;
+    for (double sample : samples) variance += (sample - mean) * (sample - mean);
+    variance /= samples.size();
+    std::sort(samples.begin(), samples.end());
+
+    result.name = name;
+    result.category = category.name;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.stddevPercent = mean > 0 ? 100.0 * std::sqrt(variance) / mean : 0;
+    result.allocsPerOp = static_cast<double>(allocationCount() - startAllocations) / totalOps;
+    result.ops = totalOps;
+    return true;
+}
+
+std::vector<BenchResult> runAll(const BenchConfig& config, std::vector<Category>& categories) {
+    std::vector<BenchResult> results;
+    for (Category& category : categories) {
+        const Category& c = category;
+        std::vector<std::pair<std::string, std::function<uint64_t()>>> benches = {
+            { "isValidMove", [&c]() {
+                uint64_t hits = 0;
+                for (const auto& s : c.candidates) hits += c.boards[s.board]->isValidMove(s.fromRow, s.fromCol, s.toRow, s.toCol, c.sides[s.board]);
+                sink = sink + hits;
+                return static_cast<uint64_t>(c.candidates.size());
+            } },
+            { "isJumpPossible", [&c]() {
+                uint64_t hits = 0;
+                for (const auto& s : c.jumps) hits += c.boards[s.board]->isJumpPossible(s.fromRow, s.fromCol, s.toRow, s.toCol, c.sides[s.board]);
+                sink = sink + hits;
+                return static_cast<uint64_t>(c.jumps.size());
+            } },
+            { "canJumpFrom", [&c]() {
+                uint64_t hits = 0;
+                for (const auto& p : c.pieces) hits += c.boards[p.board]->canJumpFrom(p.row, p.col, c.sides[p.board]);
+                sink = sink + hits;
+                return static_cast<uint64_t>(c.pieces.size());
+            } },
+            { "getPossibleMoves", [&c]() {
+                uint64_t total = 0;
+                for (const auto& p : c.pieces) total += c.boards[p.board]->getPossibleMoves(p.row, p.col, c.sides[p.board]).size();
+                sink = sink + total;
+                return static_cast<uint64_t>(c.pieces.size());
+            } },
+            { "getRequiredJumps", [&c]() {
+                uint64_t total = 0;
+                for (size_t b = 0; b < c.boards.size(); ++b) total += c.boards[b]->getRequiredJumps(c.sides[b]).size();
+                sink = sink + total;
+                return static_cast<uint64_t>(c.boards.size());
+            } },
+            //       (setPiece/clearPiece),     
+            { "makeMove", [&c]() {
+                uint64_t made = 0;
+                for (const auto& s : c.quietMoves) {
+                    Board& board = *c.boards[s.board];
+                    Piece* piece = board.getPiece(s.fromRow, s.fromCol);
+                    made += board.makeMove(s.fromRow, s.fromCol, s.toRow, s.toCol, c.sides[s.board]);
+                    board.setPiece(s.fromRow, s.fromCol, piece);
+                    board.clearPiece(s.toRow, s.toCol);
+                }
+                sink = sink + made;
+                return static_cast<uint64_t>(c.quietMoves.size());
+            } },
+            { "Game::checkGameEnd", [&c]() {
+                uint64_t ended = 0;
+                for (const auto& game : c.games) ended += GameBench::checkGameEnd(*game);
+                sink = sink + ended;
+                return static_cast<uint64_t>(c.games.size());
+            } },
+        };
+        for (const auto& bench : benches) {
+            BenchResult result;
+            if (measure(config, bench.first, category, bench.second, result)) {
+                results.push_back(result);
+            }
+        }
+    }
+    return results;
+}
+
+void printResults(const std::vector<BenchResult>& results) {
+    std::printf("%-22s %-12s %12s %9s %12s %12s\n", "benchmark", "category", "ns/op", "stddev%", "allocs/op", "ops");
+    for (const BenchResult& r : results) {
+        std::printf("%-22s %-12s %12.1f %9.1f %12.2f %12llu\n", r.name.c_str(), r.category.c_str(), r.nsPerOp,
+            r.stddevPercent, r.allocsPerOp, static_cast<unsigned long long>(r.ops));
+    }
+}
+
+// JSON:     ,         diff
+bool writeJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "{\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+            "    {\"name\": \"%s\", \"category\": \"%s\", \"nsPerOp\": %.2f, \"stddevPercent\": %.2f, \"allocsPerOp\": %.3f, \"ops\": %llu}%s\n",
+            r.name.c_str(), r.category.c_str(), r.nsPerOp, r.stddevPercent, r.allocsPerOp,
+            static_cast<unsigned long long>(r.ops), i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+std::string jsonString(const std::string& line, const std::string& key) {
+    size_t pos = line.find("\"" + key + "\": \"");
+    if (pos == std::string::npos) return "";
+    pos += key.size() + 5;
+    size_t end = line.find('"', pos);
+    return end == std::string::npos ? "" : line.substr(pos, end - pos);
+}
+
+double jsonNumber(const std::string& line, const std::string& key) {
+    size_t pos = line.find("\"" + key + "\": ");
+    return pos == std::string::npos ? 0 : std::atof(line.c_str() + pos + key.size() + 4);
+}
+
+//  ,  writeJson
+bool readJson(const std::string& path, std::vector<BenchResult>& results) {
+    std::ifstream input(path);
+    if (!input) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(input, line)) {
+        BenchResult r;
+        r.name = jsonString(line, "name");
+        if (r.name.empty()) continue;
+        r.category = jsonString(line, "category");
+        r.nsPerOp = jsonNumber(line, "nsPerOp");
+        r.stddevPercent = jsonNumber(line, "stddevPercent");
+        r.allocsPerOp = jsonNumber(line, "allocsPerOp");
+        results.push_back(r);
+    }
+    return true;
+}
+
+//  -    (     )   
+int compareWithBaseline(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline, double thresholdPercent) {
+    std::map<std::string, const BenchResult*> byKey;
+    for (const BenchResult& b : baseline) {
+        byKey[b.name + "/" + b.category] = &b;
+    }
+    int regressions = 0;
+    std::printf("\n%-22s %-12s %12s %12s %9s  %s\n", "benchmark", "category", "base ns/op", "ns/op", "change%", "status");
+    for (const BenchResult& r : results) {
+        auto it = byKey.find(r.name + "/" + r.category);
+        if (it == byKey.end()) {
+            std::printf("%-22s %-12s %12s %12.1f %9s  new\n", r.name.c_str(), r.category.c_str(), "-", r.nsPerOp, "-");
+            continue;
+        }
+        const BenchResult& b = *it->second;
+        double change = b.nsPerOp > 0 ? 100.0 * (r.nsPerOp - b.nsPerOp) / b.nsPerOp : 0;
+        double allowed = std::max(thresholdPercent, 2 * std::max(r.stddevPercent, b.stddevPercent));
+        const char* status = "ok";
+        if (change > allowed) {
+            status = "REGRESSION";
+        }
+        else if (r.allocsPerOp > b.allocsPerOp + 0.01) {
+            status = "REGRESSION (allocations)";
+        }
+        else if (change < -allowed) {
+            status = "faster";
+        }
+        if (status[0] == 'R') ++regressions;
+        std::printf("%-22s %-12s %12.1f %12.1f %+9.1f  %s\n", r.name.c_str(), r.category.c_str(), b.nsPerOp, r.nsPerOp, change, status);
+    }
+    std::printf("%d regression(s)\n", regressions);
+    return regressions;
+}
+
+std::string getOption(const std::vector<std::string>& args, const std::string& name, const std::string& defaultValue) {
+    for (size_t i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == name) {
+            return args[i + 1];
+        }
+    }
+    return defaultValue;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    BenchConfig config;
+    config.corpusPath = getOption(args, "--corpus", "");
+    config.jsonPath = getOption(args, "--json", "");
+    config.baselinePath = getOption(args, "--baseline", "");
+    config.samples = std::max(2, std::stoi(getOption(args, "--samples", "10")));
+    config.minTimeMs = std::max(1, std::stoi(getOption(args, "--min-time", "20")));
+    config.thresholdPercent = std::stod(getOption(args, "--threshold", "10"));
+
+    //   corpus.txt   (   )   cheta_bench/ (  )
+    std::vector<Category> categories;
+    bool loaded = config.corpusPath.empty() ?
+        (loadCorpus("corpus.txt", categories) || loadCorpus("cheta_bench/corpus.txt", categories)) :
+        loadCorpus(config.corpusPath, categories);
+    if (!loaded) {
+        std::cerr << "Cannot read corpus (use --corpus PATH)" << std::endl;
+        return 1;
+    }
+    for (Category& category : categories) {
+        prepare(category);
+    }
+
+    std::vector<BenchResult> results = runAll(config, categories);
+    printResults(results);
+
+    if (!config.jsonPath.empty() && !writeJson(config.jsonPath, results)) {
+        std::cerr << "Cannot write " << config.jsonPath << std::endl;
+        return 1;
+    }
+    if (!config.baselinePath.empty()) {
+        std::vector<BenchResult> baseline;
+        if (!readJson(config.baselinePath, baseline)) {
+            std::cerr << "Cannot read baseline " << config.baselinePath << std::endl;
+            return 1;
+        }
+        return compareWithBaseline(results, baseline, config.thresholdPercent) == 0 ? 0 : 1;
+    }
+    return 0;
+}